@@ -0,0 +1,228 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_Align.h"
+
+MMA7455_Align::MMA7455_Align(void)
+{
+  this->_count   = 0;
+  this->_grid_us = 0;
+  this->reset();
+}
+
+bool MMA7455_Align::begin(uint8_t streams, uint32_t grid_us)
+{
+  if(streams == 0 || streams > MMA7455_ALIGN_MAX_STREAMS)   return false;
+  if(grid_us == 0)  return false;
+  this->_count   = streams;
+  this->_grid_us = grid_us;
+  this->reset();
+  return true;
+}
+
+void MMA7455_Align::reset(void)
+{
+  memset(this->_streams, 0, sizeof(this->_streams));
+  this->_next    = 0;
+  this->_started = false;
+  this->_late    = 0;
+  return;
+}
+
+bool MMA7455_Align::add(uint8_t stream, const MMA7455_SAMPLE* sample)
+{
+  STREAM*  s     = NULL;
+  uint32_t last  = 0;
+  uint32_t pred  = 0;
+  int32_t  sum   = 0;
+  int32_t  err   = 0;
+  int32_t  half  = 0;
+  uint8_t  frac  = 0;
+  uint8_t  skip  = 0;
+  
+  if(stream >= this->_count || sample == NULL)  return false;
+  s    = &this->_streams[stream];
+  last = s->time[MMA7455_ALIGN_DEPTH - 1];
+  
+  if(s->count > 0 && s->period == 0)
+  {
+    /* first period measured, until the tracker refines it */
+    sum = (int32_t)(sample->time - last);
+    if(sum > 0)   s->period = sum << 8;
+  }
+  
+  if(s->count == 0 || s->period == 0)
+  {
+    pred = sample->time;
+  }
+  else
+  {
+    /* predicted time of the next sample */
+    sum  = (int32_t)s->frac + s->period;
+    pred = last + (sum >> 8);
+    frac = sum & 0xFF;
+    err  = (int32_t)(sample->time - pred);
+    half = s->period >> 9;
+    
+    /* missed samples: one period or more late */
+    while(err > half && skip < MMA7455_ALIGN_MAX_MISSED)
+    {
+      sum  = (int32_t)frac + s->period;
+      pred += sum >> 8;
+      frac = sum & 0xFF;
+      err  = (int32_t)(sample->time - pred);
+      skip++;
+    }
+    s->missed += skip;
+    
+    if(err > half || err < -half)
+    {
+      /* lost track, restart from this sample */
+      pred = sample->time;
+      frac = 0;
+    }
+    else
+    {
+      /* alpha-beta update of time and period */
+      sum  = (int32_t)frac + ((err * 256) >> MMA7455_ALIGN_ALPHA_SHIFT);
+      pred += sum >> 8;
+      frac = sum & 0xFF;
+      s->period += (err * 256) >> MMA7455_ALIGN_BETA_SHIFT;
+    }
+  }
+  
+  memmove(&s->time[0], &s->time[1], sizeof(s->time) - sizeof(s->time[0]));
+  memmove(&s->x[0], &s->x[1], sizeof(s->x) - sizeof(s->x[0]));
+  memmove(&s->y[0], &s->y[1], sizeof(s->y) - sizeof(s->y[0]));
+  memmove(&s->z[0], &s->z[1], sizeof(s->z) - sizeof(s->z[0]));
+  s->time[MMA7455_ALIGN_DEPTH - 1] = pred;
+  s->x[MMA7455_ALIGN_DEPTH - 1]    = sample->x;
+  s->y[MMA7455_ALIGN_DEPTH - 1]    = sample->y;
+  s->z[MMA7455_ALIGN_DEPTH - 1]    = sample->z;
+  s->frac = frac;
+  if(s->count < MMA7455_ALIGN_DEPTH)  s->count++;
+  return true;
+}
+
+bool MMA7455_Align::acquire(uint8_t stream, MMA_7455* accel)
+{
+  MMA7455_SAMPLE sample;
+  
+  if(stream >= this->_count || accel == NULL)   return false;
+  if(!accel->readSample(&sample))   return false;
+  
+  /* nominal period until measured */
+  if(this->_streams[stream].period == 0 && this->_streams[stream].count > 0)
+  {
+    this->_streams[stream].period = (int32_t)accel->getSamplePeriod() << 8;
+  }
+  return this->add(stream, &sample);
+}
+
+bool MMA7455_Align::getFrame(MMA7455_FRAME* frame)
+{
+  const STREAM* s     = NULL;
+  uint32_t      first = 0;
+  uint32_t      old   = 0;
+  uint8_t       i     = 0;
+  
+  if(frame == NULL || this->_count == 0)  return false;
+  
+  for(i = 0; i < this->_count; i++)
+  {
+    s = &this->_streams[i];
+    if(s->count < 2)  return false;
+    /* oldest time held by all streams */
+    old = s->time[MMA7455_ALIGN_DEPTH - s->count];
+    if(i == 0 || (int32_t)(old - first) > 0)  first = old;
+  }
+  
+  if(!this->_started)
+  {
+    this->_next    = first;
+    this->_started = true;
+  }
+  else if((int32_t)(first - this->_next) > 0)
+  {
+    /* frames not drained in time, catch up */
+    while((int32_t)(first - this->_next) > 0)
+    {
+      this->_next += this->_grid_us;
+      if(this->_late < 0xFFFF)  this->_late++;
+    }
+  }
+  
+  for(i = 0; i < this->_count; i++)
+  {
+    s = &this->_streams[i];
+    if((int32_t)(s->time[MMA7455_ALIGN_DEPTH - 1] - this->_next) < 0)   return false;
+  }
+  
+  frame->time  = this->_next;
+  frame->count = this->_count;
+  for(i = 0; i < this->_count; i++)
+  {
+    s = &this->_streams[i];
+    frame->x[i] = this->_interpolate(s->x, s);
+    frame->y[i] = this->_interpolate(s->y, s);
+    frame->z[i] = this->_interpolate(s->z, s);
+  }
+  this->_next += this->_grid_us;
+  return true;
+}
+
+int32_t MMA7455_Align::getPeriod(uint8_t stream)
+{
+  if(stream >= this->_count)  return 0;
+  return this->_streams[stream].period;
+}
+
+uint16_t MMA7455_Align::getMissed(uint8_t stream)
+{
+  if(stream >= this->_count)  return 0;
+  return this->_streams[stream].missed;
+}
+
+uint16_t MMA7455_Align::getLate(void)
+{
+  return this->_late;
+}
+
+int16_t MMA7455_Align::_interpolate(const int16_t* val, const STREAM* s)
+{
+  const uint32_t* time = s->time;
+  uint8_t oldest = MMA7455_ALIGN_DEPTH - s->count;
+  int32_t span = 0;
+  int32_t pos  = 0;
+  int32_t diff = 0;
+  uint8_t j    = MMA7455_ALIGN_DEPTH - 1;
+  
+  /* pair around the grid time, searched from the newest */
+  while(j > oldest + 1 && (int32_t)(time[j - 1] - this->_next) > 0)  j--;
+  
+  span = (int32_t)(time[j] - time[j - 1]);
+  pos  = (int32_t)(this->_next - time[j - 1]);
+  diff = (int32_t)val[j] - val[j - 1];
+  if(span <= 0)   return val[j];
+  
+  /* rounded to nearest */
+  diff = diff * pos;
+  diff = (diff >= 0) ? (diff + span / 2) / span : -((-diff + span / 2) / span);
+  return (int16_t)(val[j - 1] + diff);
+}
@@ -0,0 +1,99 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_Align
+ *  Desc.:     Time alignment of several accelerometers
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Each MMA7455 samples on its own oscillator: the streams
+ *    drift apart. The sample times (taken on the host clock,
+ *    the common reference) are fed per stream to an alpha-beta
+ *    tracker, which estimates the stream period (so its rate
+ *    against the host clock) and a jitter-free sample time, and
+ *    steps over missed samples.
+ *
+ *    The streams are then linearly interpolated on a common grid
+ *    and output as frames holding one sample per stream. Frames
+ *    are ready once every stream went past the grid time: call
+ *    getFrame() until it returns false after each add().
+ *
+ */
+
+#ifndef __MMA7455_ALIGN_H__
+#define __MMA7455_ALIGN_H__
+
+#include "MMA_7455.h"
+
+#define MMA7455_ALIGN_MAX_STREAMS   (4)
+#define MMA7455_ALIGN_ALPHA_SHIFT   (3)   /* time gain 1/8 */
+#define MMA7455_ALIGN_BETA_SHIFT    (8)   /* period gain 1/256 */
+#define MMA7455_ALIGN_MAX_MISSED    (8)   /* resync beyond */
+#define MMA7455_ALIGN_DEPTH         (4)   /* samples held per stream */
+
+/* Aligned samples of all streams */
+typedef struct _MMA7455_FRAME
+{
+  uint32_t time;                          /* grid time, 1 = 1 us */
+  uint8_t  count;                         /* streams */
+  int16_t  x[MMA7455_ALIGN_MAX_STREAMS];
+  int16_t  y[MMA7455_ALIGN_MAX_STREAMS];
+  int16_t  z[MMA7455_ALIGN_MAX_STREAMS];
+} MMA7455_FRAME;
+
+class MMA7455_Align
+{
+  public:
+    MMA7455_Align(void);
+    
+    bool    begin(uint8_t streams, uint32_t grid_us);
+    void    reset(void);
+    bool    add(uint8_t stream, const MMA7455_SAMPLE* sample);
+    bool    acquire(uint8_t stream, MMA_7455* accel);
+    bool    getFrame(MMA7455_FRAME* frame);
+    
+    int32_t  getPeriod(uint8_t stream);   /* 1 = 1/256 us */
+    uint16_t getMissed(uint8_t stream);
+    uint16_t getLate(void);
+  
+  private:
+    typedef struct _STREAM
+    {
+      uint32_t time[MMA7455_ALIGN_DEPTH];   /* smoothed, newest last */
+      int16_t  x[MMA7455_ALIGN_DEPTH];
+      int16_t  y[MMA7455_ALIGN_DEPTH];
+      int16_t  z[MMA7455_ALIGN_DEPTH];
+      int32_t  period;    /* 1 = 1/256 us, 0 = unknown */
+      uint8_t  frac;      /* newest time fraction, 1 = 1/256 us */
+      uint8_t  count;     /* samples held */
+      uint16_t missed;
+    } STREAM;
+    
+    STREAM   _streams[MMA7455_ALIGN_MAX_STREAMS];
+    uint8_t  _count;
+    uint32_t _grid_us;
+    uint32_t _next;       /* next grid time */
+    bool     _started;
+    uint16_t _late;       /* grid times skipped */
+    
+    int16_t _interpolate(const int16_t* val, const STREAM* s);
+};
+
+#endif /* __MMA7455_ALIGN_H__ */
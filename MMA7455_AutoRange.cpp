@@ -0,0 +1,139 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_AutoRange.h"
+
+MMA7455_AutoRange::MMA7455_AutoRange(MMA_7455* accel)
+{
+  this->_accel    = accel;
+  this->_range    = 0;
+  this->_shift    = 0;
+  this->_min      = 2;
+  this->_max      = 8;
+  this->_up       = MMA7455_RANGE_UP;
+  this->_down     = MMA7455_RANGE_DOWN;
+  this->_hold     = MMA7455_RANGE_HOLD;
+  this->_quiet    = 0;
+  this->_switches = 0;
+  this->_settle   = false;
+}
+
+bool MMA7455_AutoRange::begin(uint8_t min_range, uint8_t max_range)
+{
+  uint8_t range = 0;
+  
+  if(this->_accel == NULL)  return false;
+  if(min_range != 2 && min_range != 4 && min_range != 8)  return false;
+  if(max_range != 2 && max_range != 4 && max_range != 8)  return false;
+  if(min_range > max_range)   return false;
+  this->_min = min_range;
+  this->_max = max_range;
+  
+  /* one read to seed the cache, then clamp to the limits */
+  range = this->_accel->getSensitivity();
+  if(this->_accel->getLastError() != mma_ok)  return false;
+  if(range < this->_min)  range = this->_min;
+  if(range > this->_max)  range = this->_max;
+  if(!this->_select(range))   return false;
+  this->_switches = 0;
+  return true;
+}
+
+void MMA7455_AutoRange::setThresholds(uint8_t up, uint8_t down, uint16_t hold)
+{
+  /* keep the hysteresis: a down switch doubles the values */
+  if(up > 127)  up = 127;
+  if(down > up / 2)   down = up / 2;
+  this->_up    = up;
+  this->_down  = down;
+  this->_hold  = hold;
+  this->_quiet = 0;
+  return;
+}
+
+uint8_t MMA7455_AutoRange::getRange(void)
+{
+  return this->_range;
+}
+
+uint16_t MMA7455_AutoRange::getSwitchCount(void)
+{
+  return this->_switches;
+}
+
+bool MMA7455_AutoRange::readSample(MMA7455_RANGED* sample)
+{
+  int8_t  val[3] = {0};
+  uint8_t peak   = 0;
+  uint8_t mag    = 0;
+  uint8_t i      = 0;
+  
+  if(sample == NULL || this->_range == 0)   return false;
+  if(!this->_accel->readSample8(&val[0], &val[1], &val[2]))   return false;
+  if(this->_settle)
+  {
+    this->_settle = false;
+    return false;
+  }
+  
+  for(i = 0; i < 3; i++)
+  {
+    mag = (val[i] < 0) ? (uint8_t)(-(int16_t)val[i]) : (uint8_t)val[i];
+    if(mag > peak)  peak = mag;
+  }
+  
+  sample->time    = this->_accel->getSampleTime();
+  /* multiplied: a left shift of a negative value is undefined */
+  sample->x       = (int16_t)val[0] * (1 << this->_shift);
+  sample->y       = (int16_t)val[1] * (1 << this->_shift);
+  sample->z       = (int16_t)val[2] * (1 << this->_shift);
+  sample->range   = this->_range;
+  sample->clipped = (peak >= 127);
+  
+  /* range for the next samples */
+  if(peak >= this->_up)
+  {
+    this->_quiet = 0;
+    if(this->_range < this->_max)   this->_select(this->_range * 2);
+  }
+  else if(peak < this->_down && this->_range > this->_min)
+  {
+    if(++this->_quiet >= this->_hold)   this->_select(this->_range / 2);
+  }
+  else
+  {
+    this->_quiet = 0;
+  }
+  return true;
+}
+
+bool MMA7455_AutoRange::_select(uint8_t range)
+{
+  this->_quiet = 0;
+  if(range == this->_range)   return true;
+  
+  this->_accel->setSensitivity(range);
+  if(this->_accel->getLastError() != mma_ok)  return false;
+  
+  this->_settle = (this->_range != 0);
+  this->_range  = range;
+  this->_shift  = (range == 8) ? 2 : (range == 4) ? 1 : 0;
+  this->_switches++;
+  return true;
+}
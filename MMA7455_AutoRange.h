@@ -0,0 +1,90 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_AutoRange
+ *  Desc.:     Automatic 2g/4g/8g range switching of 8-bit samples
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    The 8-bit outputs follow GLVL (64, 32 or 16 counts/g), the
+ *    10-bit outputs are always 8g, so only the 8-bit samples are
+ *    worth ranging.
+ *
+ *    A sample near full scale switches to the next wider range
+ *    at once. When all axes stayed under the down threshold for
+ *    'hold' samples, the next finer range is selected. The down
+ *    threshold is below half the up one: after a down switch,
+ *    the same values do not trigger an up switch (hysteresis).
+ *
+ *    The range is cached, the values are scaled by a shift and
+ *    output in 1/64 g whatever the range. A switch costs one
+ *    MCTL read-modify-write, the next sample is dropped since it
+ *    may have been converted in the previous range.
+ *
+ */
+
+#ifndef __MMA7455_AUTORANGE_H__
+#define __MMA7455_AUTORANGE_H__
+
+#include "MMA_7455.h"
+
+#define MMA7455_RANGE_UP      (120)   /* |8-bit| >= : wider range */
+#define MMA7455_RANGE_DOWN    (56)    /* |8-bit| < : finer range */
+#define MMA7455_RANGE_HOLD    (25)    /* samples under 'down' */
+
+/* Sample tagged with its range */
+typedef struct _MMA7455_RANGED
+{
+  uint32_t time;      /* 1 = 1 us */
+  int16_t  x;         /* 1 = 1/64 g */
+  int16_t  y;
+  int16_t  z;
+  uint8_t  range;     /* 2, 4 or 8 g */
+  bool     clipped;   /* an axis was at full scale */
+} MMA7455_RANGED;
+
+class MMA7455_AutoRange
+{
+  public:
+    MMA7455_AutoRange(MMA_7455* accel);
+    
+    bool    begin(uint8_t min_range = 2, uint8_t max_range = 8);
+    void    setThresholds(uint8_t up, uint8_t down, uint16_t hold);
+    uint8_t getRange(void);
+    uint16_t getSwitchCount(void);
+    bool    readSample(MMA7455_RANGED* sample);
+  
+  private:
+    MMA_7455* _accel;
+    uint8_t  _range;
+    uint8_t  _shift;     /* 1/64 g = count * 2^shift */
+    uint8_t  _min;
+    uint8_t  _max;
+    uint8_t  _up;
+    uint8_t  _down;
+    uint16_t _hold;
+    uint16_t _quiet;     /* samples under 'down' */
+    uint16_t _switches;
+    bool     _settle;    /* drop the next sample */
+    
+    bool    _select(uint8_t range);
+};
+
+#endif /* __MMA7455_AUTORANGE_H__ */
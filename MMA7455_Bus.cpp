@@ -0,0 +1,125 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_Bus.h"
+
+#if defined(MMA7455_HOST)
+#include <sched.h>
+#define MMA7455_BUS_ATOMIC
+#elif defined(ESP32)
+/* spinlock: also excludes the other core, nests in handlers */
+#define MMA7455_CRITICAL_BEGIN  portENTER_CRITICAL_SAFE(&this->_mux);
+#define MMA7455_CRITICAL_END    portEXIT_CRITICAL_SAFE(&this->_mux);
+#elif defined(ESP8266)
+/* save PS, a handler may call it with interrupts off */
+#define MMA7455_CRITICAL_BEGIN  uint32_t _ps = xt_rsil(15);
+#define MMA7455_CRITICAL_END    xt_wsr_ps(_ps);
+#elif defined(__AVR__)
+/* save SREG, a handler may call it with interrupts off */
+#define MMA7455_CRITICAL_BEGIN  uint8_t _sreg = SREG; cli();
+#define MMA7455_CRITICAL_END    SREG = _sreg;
+#elif defined(__arm__)
+/* save PRIMASK, valid on every Cortex-M */
+#define MMA7455_CRITICAL_BEGIN  uint32_t _primask;                      \
+                                __asm__ volatile("mrs %0, primask\n"    \
+                                                 "cpsid i"              \
+                                                 : "=r" (_primask)      \
+                                                 :: "memory");
+#define MMA7455_CRITICAL_END    __asm__ volatile("msr primask, %0"      \
+                                                 :: "r" (_primask)      \
+                                                 : "memory");
+#elif defined(__GCC_ATOMIC_BOOL_LOCK_FREE) && (__GCC_ATOMIC_BOOL_LOCK_FREE == 2)
+/* other cores: lock-free atomics, no interrupt state to restore */
+#define MMA7455_BUS_ATOMIC
+#else
+/* noInterrupts()/interrupts() would enable the
+ * interrupts again inside a handler */
+#error "MMA7455_Bus: no critical section for this core"
+#endif
+
+MMA7455_Bus::MMA7455_Bus(void)
+{
+  this->_locked     = false;
+  this->_contention = 0;
+#if defined(ESP32) && !defined(MMA7455_HOST)
+  portMUX_TYPE mux  = portMUX_INITIALIZER_UNLOCKED;
+  this->_mux        = mux;
+#endif
+}
+
+bool MMA7455_Bus::tryLock(void)
+{
+  bool taken = false;
+  
+#if defined(MMA7455_BUS_ATOMIC)
+  taken = !__atomic_test_and_set((bool*)&this->_locked, __ATOMIC_ACQUIRE);
+  /* one atomic add, capped on read */
+  if(!taken)  __atomic_fetch_add((uint32_t*)&this->_contention, 1, __ATOMIC_RELAXED);
+#else
+  MMA7455_CRITICAL_BEGIN
+  taken = !this->_locked;
+  if(taken)   this->_locked = true;
+  else if(this->_contention < 0xFFFF)   this->_contention++;
+  MMA7455_CRITICAL_END
+#endif
+  return taken;
+}
+
+bool MMA7455_Bus::lock(uint16_t timeout_us)
+{
+  uint32_t start = 0;
+  
+  if(this->tryLock())   return true;
+  if(timeout_us == 0)   return false;
+  
+  start = micros();
+  while(!this->tryLock())
+  {
+    if(micros() - start >= timeout_us)  return false;
+#if defined(MMA7455_HOST)
+    /* let the owner run when threads outnumber cores */
+    sched_yield();
+#endif
+  }
+  return true;
+}
+
+void MMA7455_Bus::unlock(void)
+{
+#if defined(MMA7455_BUS_ATOMIC)
+  __atomic_clear((bool*)&this->_locked, __ATOMIC_RELEASE);
+#else
+  MMA7455_CRITICAL_BEGIN
+  this->_locked = false;
+  MMA7455_CRITICAL_END
+#endif
+  return;
+}
+
+bool MMA7455_Bus::isLocked(void)
+{
+  return this->_locked;
+}
+
+uint16_t MMA7455_Bus::getContention(void)
+{
+  uint32_t count = this->_contention;
+  
+  return (count > 0xFFFF) ? 0xFFFF : (uint16_t)count;
+}
@@ -0,0 +1,72 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_Bus
+ *  Desc.:     Ownership of a bus shared by several owners
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Accelerometers given the same bus with setBus() take it
+ *    for a whole burst (with its retries), never per byte: the
+ *    register address phase and the data phase of a read can
+ *    not be split by another owner (an interrupt handler, an
+ *    RTOS thread, or a host thread on a replay).
+ *
+ *    The lock is taken in a critical section that saves and
+ *    restores the interrupt state, so it is safe from an
+ *    interrupt handler; on the ESP32 it is a spinlock shared by
+ *    both cores. Cortex-M (PRIMASK) is single core only: on a
+ *    dual core RP2040, share a bus from one core. A transfer is
+ *    short, so a waiting owner spins until its timeout; a
+ *    handler must use a timeout of 0 and gets mma_busy instead
+ *    of deadlocking on the code it interrupted.
+ *
+ *    The driver calls lock() and unlock() through the object
+ *    (virtual), so this file is only linked by the programs
+ *    creating a bus, and a subclass can take an RTOS mutex
+ *    instead.
+ *
+ */
+
+#ifndef __MMA7455_BUS_H__
+#define __MMA7455_BUS_H__
+
+#include "MMA_7455.h"
+
+class MMA7455_Bus
+{
+  public:
+    MMA7455_Bus(void);
+    
+    virtual bool tryLock(void);
+    virtual bool lock(uint16_t timeout_us);
+    virtual void unlock(void);
+    bool    isLocked(void);
+    uint16_t getContention(void);   /* attempts found busy, up to 0xFFFF */
+  
+  private:
+    volatile bool     _locked;
+    volatile uint32_t _contention;
+#if defined(ESP32) && !defined(MMA7455_HOST)
+    portMUX_TYPE      _mux;
+#endif
+};
+
+#endif /* __MMA7455_BUS_H__ */
@@ -0,0 +1,84 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_Calib.h"
+
+#if defined(MMA7455_HOST)
+#include <stdio.h>
+#endif
+
+bool MMA7455_loadCalibration(MMA7455_CALIB* calib, const MMA7455_STORE* store, uint16_t addr)
+{
+  if(calib == NULL || store == NULL || store->read == NULL)   return false;
+  if(!store->read(store->ctx, addr, (uint8_t*)calib, sizeof(*calib)))   return false;
+  return MMA7455_checkCalibration(calib);
+}
+
+bool MMA7455_saveCalibration(const MMA7455_CALIB* calib, const MMA7455_STORE* store, uint16_t addr)
+{
+  if(store == NULL || store->write == NULL)   return false;
+  if(!MMA7455_checkCalibration(calib))  return false;
+  return store->write(store->ctx, addr, (const uint8_t*)calib, sizeof(*calib));
+}
+
+#if defined(MMA7455_HOST)
+bool MMA7455_loadCalibration(MMA7455_CALIB* calib, const char* path)
+{
+  FILE*  file = NULL;
+  size_t len  = 0;
+  
+  if(calib == NULL || path == NULL)   return false;
+  file = fopen(path, "rb");
+  if(file == NULL)  return false;
+  len = fread(calib, 1, sizeof(*calib), file);
+  fclose(file);
+  return len == sizeof(*calib) && MMA7455_checkCalibration(calib);
+}
+
+bool MMA7455_saveCalibration(const MMA7455_CALIB* calib, const char* path)
+{
+  FILE*  file = NULL;
+  size_t len  = 0;
+  
+  if(!MMA7455_checkCalibration(calib) || path == NULL)  return false;
+  file = fopen(path, "wb");
+  if(file == NULL)  return false;
+  len = fwrite(calib, 1, sizeof(*calib), file);
+  if(fclose(file) != 0)   return false;
+  return len == sizeof(*calib);
+}
+#endif
+
+void MMA7455_applyScale(const MMA7455_CALIB* calib,
+                        int16_t* x, int16_t* y, int16_t* z)
+{
+  int16_t* val[3] = {x, y, z};
+  int32_t  prod   = 0;
+  uint8_t  i      = 0;
+  
+  if(calib == NULL)   return;
+  for(i = 0; i < 3; i++)
+  {
+    if(val[i] == NULL)  continue;
+    /* rounded to nearest */
+    prod = (int32_t)*val[i] * calib->scale[i] + MMA7455_SCALE_ONE / 2;
+    *val[i] = (int16_t)(prod >> 14);
+  }
+  return;
+}
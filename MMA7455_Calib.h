@@ -0,0 +1,66 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_Calib
+ *  Desc.:     Storage of the calibration record
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    The record is stored as is, so it must be read back by
+ *    the same architecture. It is checked on load (version,
+ *    range and CRC): a blank or worn EEPROM, or a file of
+ *    another format, is rejected.
+ *
+ *    The record is read and written through a caller provided
+ *    store (byte read and write callbacks), so the core does
+ *    not depend on any storage library. The EEPROM store is
+ *    opt-in: include MMA7455_EEPROM.h in the sketch. On a host
+ *    build the record can also go to a file.
+ *
+ */
+
+#ifndef __MMA7455_CALIB_H__
+#define __MMA7455_CALIB_H__
+
+#include "MMA_7455.h"
+
+/* Byte storage, false on failure; ctx is passed through */
+typedef bool (*MMA7455_STORE_READ)(void* ctx, uint16_t addr, uint8_t* data, uint16_t len);
+typedef bool (*MMA7455_STORE_WRITE)(void* ctx, uint16_t addr, const uint8_t* data, uint16_t len);
+
+typedef struct _MMA7455_STORE
+{
+  MMA7455_STORE_READ  read;
+  MMA7455_STORE_WRITE write;
+  void*               ctx;
+} MMA7455_STORE;
+
+bool    MMA7455_loadCalibration(MMA7455_CALIB* calib, const MMA7455_STORE* store, uint16_t addr);
+bool    MMA7455_saveCalibration(const MMA7455_CALIB* calib, const MMA7455_STORE* store, uint16_t addr);
+#if defined(MMA7455_HOST)
+bool    MMA7455_loadCalibration(MMA7455_CALIB* calib, const char* path);
+bool    MMA7455_saveCalibration(const MMA7455_CALIB* calib, const char* path);
+#endif
+
+/* Gain correction of a 10-bit sample */
+void    MMA7455_applyScale(const MMA7455_CALIB* calib,
+                           int16_t* x, int16_t* y, int16_t* z);
+
+#endif /* __MMA7455_CALIB_H__ */
@@ -0,0 +1,113 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_DeadBand.h"
+
+MMA7455_DeadBand::MMA7455_DeadBand(void)
+{
+  this->_band         = 0;
+  this->_heartbeat_us = 0;
+  this->reset();
+}
+
+void MMA7455_DeadBand::begin(uint16_t band, uint32_t heartbeat_ms)
+{
+  if(heartbeat_ms > MMA7455_DEADBAND_MAX_HEARTBEAT)
+  {
+    heartbeat_ms = MMA7455_DEADBAND_MAX_HEARTBEAT;
+  }
+  this->_band         = band;
+  this->_heartbeat_us = heartbeat_ms * 1000UL;
+  this->reset();
+  return;
+}
+
+void MMA7455_DeadBand::reset(void)
+{
+  memset(&this->_last, 0, sizeof(this->_last));
+  this->_valid            = false;
+  this->_suppressed       = 0;
+  this->_pending          = 0;
+  this->_suppressed_total = 0;
+  this->_reported_total   = 0;
+  return;
+}
+
+REPORT_REASON MMA7455_DeadBand::add(const MMA7455_SAMPLE* sample)
+{
+  REPORT_REASON reason = report_none;
+  int32_t       band   = this->_band;
+  
+  if(sample == NULL)  return report_none;
+  
+  if(!this->_valid)
+  {
+    reason = report_first;
+  }
+  else if((int32_t)sample->x - this->_last.x > band ||
+          (int32_t)this->_last.x - sample->x > band ||
+          (int32_t)sample->y - this->_last.y > band ||
+          (int32_t)this->_last.y - sample->y > band ||
+          (int32_t)sample->z - this->_last.z > band ||
+          (int32_t)this->_last.z - sample->z > band)
+  {
+    reason = report_motion;
+  }
+  else if(this->_heartbeat_us != 0 &&
+          sample->time - this->_last.time >= this->_heartbeat_us)
+  {
+    reason = report_heartbeat;
+  }
+  
+  if(reason == report_none)
+  {
+    if(this->_suppressed < 0xFFFF)  this->_suppressed++;
+    this->_suppressed_total++;
+    return report_none;
+  }
+  
+  this->_last       = *sample;
+  this->_valid      = true;
+  this->_pending    = this->_suppressed;
+  this->_suppressed = 0;
+  this->_reported_total++;
+  return reason;
+}
+
+REPORT_REASON MMA7455_DeadBand::acquire(MMA_7455* accel, MMA7455_SAMPLE* sample)
+{
+  if(accel == NULL || sample == NULL)   return report_none;
+  if(!accel->readSample(sample))  return report_none;
+  return this->add(sample);
+}
+
+uint16_t MMA7455_DeadBand::getSuppressed(void)
+{
+  return this->_pending;
+}
+
+uint32_t MMA7455_DeadBand::getSuppressedTotal(void)
+{
+  return this->_suppressed_total;
+}
+
+uint32_t MMA7455_DeadBand::getReportedTotal(void)
+{
+  return this->_reported_total;
+}
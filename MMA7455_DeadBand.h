@@ -0,0 +1,79 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_DeadBand
+ *  Desc.:     Change detection reporting with a heartbeat
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    A sample is reported only when an axis moved beyond the
+ *    dead band from the last reported sample, or when the
+ *    heartbeat interval expired since the last report. The
+ *    reference is the last reported sample, not the previous
+ *    one, so a slow drift is reported once it adds up.
+ *
+ *    Suppressed samples are counted, the count since the last
+ *    report can be sent along with it.
+ *
+ */
+
+#ifndef __MMA7455_DEADBAND_H__
+#define __MMA7455_DEADBAND_H__
+
+#include "MMA_7455.h"
+
+/* Heartbeat limited by the 32-bit microsecond sample time */
+#define MMA7455_DEADBAND_MAX_HEARTBEAT  (4294967UL)
+
+/* Reason of a report */
+typedef enum _REPORT_REASON
+{
+  report_none = 0,   /* suppressed */
+  report_first,      /* first sample since reset */
+  report_motion,     /* dead band exceeded */
+  report_heartbeat   /* heartbeat expired */
+} REPORT_REASON;
+
+class MMA7455_DeadBand
+{
+  public:
+    MMA7455_DeadBand(void);
+    
+    void    begin(uint16_t band, uint32_t heartbeat_ms = 0);
+    void    reset(void);
+    REPORT_REASON add(const MMA7455_SAMPLE* sample);
+    REPORT_REASON acquire(MMA_7455* accel, MMA7455_SAMPLE* sample);
+    
+    uint16_t getSuppressed(void);      /* before the last report */
+    uint32_t getSuppressedTotal(void);
+    uint32_t getReportedTotal(void);
+  
+  private:
+    MMA7455_SAMPLE _last;
+    uint32_t _heartbeat_us; /* 0 = off */
+    uint16_t _band;
+    bool     _valid;
+    uint16_t _suppressed;
+    uint16_t _pending;      /* suppressed before the current report */
+    uint32_t _suppressed_total;
+    uint32_t _reported_total;
+};
+
+#endif /* __MMA7455_DEADBAND_H__ */
@@ -0,0 +1,104 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_EEPROM
+ *  Desc.:     EEPROM store of the calibration record
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Opt-in, header only: the EEPROM library is only pulled in
+ *    by the sketches including this file, so the driver still
+ *    builds on cores without EEPROM (e.g. Arduino Due).
+ *
+ *      MMA7455_loadCalibration(&calib, &MMA7455_EEPROM_STORE, 0);
+ *
+ *    Cores emulating the EEPROM in flash (ESP8266, ESP32) need
+ *    EEPROM.begin(size) before any access: it is left to the
+ *    application, which owns the size and its other records
+ *    (calling it again would reload the flash and drop their
+ *    uncommitted writes). The store fails if the record does
+ *    not fit in EEPROM.length(), so also before begin(), and
+ *    commits the flash after a save. Define
+ *    MMA7455_EEPROM_COMMIT for other cores working the same way.
+ *
+ */
+
+#ifndef __MMA7455_EEPROM_H__
+#define __MMA7455_EEPROM_H__
+
+#include "MMA7455_Calib.h"
+
+#if defined(MMA7455_HOST)
+#error "MMA7455_EEPROM: no EEPROM on a host build, save to a file"
+#endif
+
+#if defined(ARDUINO)
+#include <EEPROM.h>
+#endif
+
+#if defined(ESP8266) || defined(ESP32)
+#define MMA7455_EEPROM_COMMIT
+#endif
+
+static inline bool mma7455_eepromRead(void* ctx, uint16_t addr, uint8_t* data, uint16_t len)
+{
+  uint16_t i = 0;
+  
+  (void)ctx;
+#if defined(MMA7455_EEPROM_COMMIT)
+  /* 0 until the application called EEPROM.begin() */
+  if((uint32_t)addr + len > EEPROM.length())  return false;
+#endif
+  for(i = 0; i < len; i++)
+  {
+    data[i] = EEPROM.read(addr + i);
+  }
+  return true;
+}
+
+static inline bool mma7455_eepromWrite(void* ctx, uint16_t addr, const uint8_t* data, uint16_t len)
+{
+  uint16_t i = 0;
+  
+  (void)ctx;
+#if defined(MMA7455_EEPROM_COMMIT)
+  /* 0 until the application called EEPROM.begin() */
+  if((uint32_t)addr + len > EEPROM.length())  return false;
+#endif
+  for(i = 0; i < len; i++)
+  {
+    /* spare the EEPROM cells that already match */
+    if(EEPROM.read(addr + i) != data[i])  EEPROM.write(addr + i, data[i]);
+  }
+#if defined(MMA7455_EEPROM_COMMIT)
+  return EEPROM.commit();
+#else
+  return true;
+#endif
+}
+
+static const MMA7455_STORE MMA7455_EEPROM_STORE =
+{
+  mma7455_eepromRead,
+  mma7455_eepromWrite,
+  NULL
+};
+
+#endif /* __MMA7455_EEPROM_H__ */
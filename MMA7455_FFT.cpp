@@ -0,0 +1,242 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_FFT.h"
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#endif
+#if !defined(PROGMEM)
+#define PROGMEM
+#endif
+#if !defined(pgm_read_word)
+#define pgm_read_word(addr)     (*(const uint16_t*)(addr))
+#endif
+
+/* 10-bit inputs are scaled up by 2^5 before the transform,
+ * every stage halves, so no stage can overflow 16 bits */
+#define MMA7455_FFT_PRESCALE    (5)
+
+/* Quarter of a 1024 points sine, Q15 */
+static const int16_t mma7455_sin_q15[257] PROGMEM =
+{
+       0,    201,    402,    603,    804,   1005,   1206,   1407,
+    1608,   1809,   2009,   2210,   2410,   2611,   2811,   3012,
+    3212,   3412,   3612,   3811,   4011,   4210,   4410,   4609,
+    4808,   5007,   5205,   5404,   5602,   5800,   5998,   6195,
+    6393,   6590,   6786,   6983,   7179,   7375,   7571,   7767,
+    7962,   8157,   8351,   8545,   8739,   8933,   9126,   9319,
+    9512,   9704,   9896,  10087,  10278,  10469,  10659,  10849,
+   11039,  11228,  11417,  11605,  11793,  11980,  12167,  12353,
+   12539,  12725,  12910,  13094,  13279,  13462,  13645,  13828,
+   14010,  14191,  14372,  14553,  14732,  14912,  15090,  15269,
+   15446,  15623,  15800,  15976,  16151,  16325,  16499,  16673,
+   16846,  17018,  17189,  17360,  17530,  17700,  17869,  18037,
+   18204,  18371,  18537,  18703,  18868,  19032,  19195,  19357,
+   19519,  19680,  19841,  20000,  20159,  20317,  20475,  20631,
+   20787,  20942,  21096,  21250,  21403,  21554,  21705,  21856,
+   22005,  22154,  22301,  22448,  22594,  22739,  22884,  23027,
+   23170,  23311,  23452,  23592,  23731,  23870,  24007,  24143,
+   24279,  24413,  24547,  24680,  24811,  24942,  25072,  25201,
+   25329,  25456,  25582,  25708,  25832,  25955,  26077,  26198,
+   26319,  26438,  26556,  26674,  26790,  26905,  27019,  27133,
+   27245,  27356,  27466,  27575,  27683,  27790,  27896,  28001,
+   28105,  28208,  28310,  28411,  28510,  28609,  28706,  28803,
+   28898,  28992,  29085,  29177,  29268,  29358,  29447,  29534,
+   29621,  29706,  29791,  29874,  29956,  30037,  30117,  30195,
+   30273,  30349,  30424,  30498,  30571,  30643,  30714,  30783,
+   30852,  30919,  30985,  31050,  31113,  31176,  31237,  31297,
+   31356,  31414,  31470,  31526,  31580,  31633,  31685,  31736,
+   31785,  31833,  31880,  31926,  31971,  32014,  32057,  32098,
+   32137,  32176,  32213,  32250,  32285,  32318,  32351,  32382,
+   32412,  32441,  32469,  32495,  32521,  32545,  32567,  32589,
+   32609,  32628,  32646,  32663,  32678,  32692,  32705,  32717,
+   32728,  32737,  32745,  32752,  32757,  32761,  32765,  32766,
+   32767
+};
+
+MMA7455_FFT::MMA7455_FFT(uint16_t n, FFT_WINDOW window)
+{
+  if(n < MMA7455_FFT_MIN)   n = MMA7455_FFT_MIN;
+  if(n > MMA7455_FFT_MAX)   n = MMA7455_FFT_MAX;
+  
+  /* round down to a power of 2 */
+  for(this->_log2 = 0; (2U << this->_log2) <= n; this->_log2++);
+  this->_n      = 1U << this->_log2;
+  this->_window = window;
+}
+
+uint16_t MMA7455_FFT::getSize(void)
+{
+  return this->_n;
+}
+
+uint16_t* MMA7455_FFT::transform(int16_t* block)
+{
+  uint16_t m    = this->_n >> 1;    /* complex points */
+  uint16_t i    = 0;
+  uint16_t j    = 0;
+  uint16_t k    = 0;
+  uint16_t len  = 0;
+  uint16_t step = 0;
+  int32_t  val  = 0;
+  int32_t  wr   = 0, wi = 0;
+  int32_t  tr   = 0, ti = 0;
+  int32_t  er   = 0, ei = 0;
+  int32_t  or_  = 0, oi = 0;
+  int16_t  tmp  = 0;
+  uint16_t* mags = (uint16_t*)block;
+  
+  if(block == NULL)   return NULL;
+  
+  /* window, Hann: sin^2(pi.i/n) */
+  for(i = 0; i < this->_n; i++)
+  {
+    val = (int32_t)block[i] * (1 << MMA7455_FFT_PRESCALE);
+    if(this->_window == fft_hann)
+    {
+      wr  = this->_sin((uint32_t)i * 512 / this->_n);
+      val = (val * ((wr * wr) >> 15)) >> 15;
+    }
+    block[i] = (int16_t)val;
+  }
+  
+  /* even/odd samples are the real/imaginary parts of
+   * m complex points: bit reversal on the pairs */
+  for(i = 1, j = 0; i < m; i++)
+  {
+    for(k = m >> 1; j & k; k >>= 1)   j ^= k;
+    j |= k;
+    if(i < j)
+    {
+      tmp = block[2*i];     block[2*i]     = block[2*j];     block[2*j]     = tmp;
+      tmp = block[2*i + 1]; block[2*i + 1] = block[2*j + 1]; block[2*j + 1] = tmp;
+    }
+  }
+  
+  /* radix-2 butterflies, scaled by 1/2 per stage */
+  for(len = 2; len <= m; len <<= 1)
+  {
+    step = 1024 / len;
+    for(i = 0; i < m; i += len)
+    {
+      for(k = 0; k < (len >> 1); k++)
+      {
+        int16_t* a = &block[2*(i + k)];
+        int16_t* b = &block[2*(i + k + (len >> 1))];
+        wr =  this->_cos(k * step);
+        wi = -this->_sin(k * step);
+        tr = (wr * b[0] - wi * b[1]) >> 15;
+        ti = (wr * b[1] + wi * b[0]) >> 15;
+        b[0] = (int16_t)((a[0] - tr) >> 1);
+        b[1] = (int16_t)((a[1] - ti) >> 1);
+        a[0] = (int16_t)((a[0] + tr) >> 1);
+        a[1] = (int16_t)((a[1] + ti) >> 1);
+      }
+    }
+  }
+  
+  /* split into the real spectrum, scaled by 1/2:
+   * X[k]   = (E + W^k.O) / 2
+   * X[m-k] = conj(E - W^k.O) / 2 */
+  val = ((int32_t)block[0] + block[1]) >> 1;
+  block[0] = (int16_t)val;
+  block[1] = 0;
+  step = 1024 / this->_n;
+  for(k = 1; k <= (m >> 1); k++)
+  {
+    int16_t* a = &block[2*k];
+    int16_t* b = &block[2*(m - k)];
+    er  = ((int32_t)a[0] + b[0]) >> 1;
+    ei  = ((int32_t)a[1] - b[1]) >> 1;
+    or_ = ((int32_t)a[1] + b[1]) >> 1;
+    oi  = ((int32_t)b[0] - a[0]) >> 1;
+    wr  =  this->_cos(k * step);
+    wi  = -this->_sin(k * step);
+    tr  = (wr * or_ - wi * oi) >> 15;
+    ti  = (wr * oi + wi * or_) >> 15;
+    a[0] = (int16_t)((er + tr) >> 1);
+    a[1] = (int16_t)((ei + ti) >> 1);
+    if(k != m - k)
+    {
+      b[0] = (int16_t)((er - tr) >> 1);
+      b[1] = (int16_t)((ti - ei) >> 1);
+    }
+  }
+  
+  /* magnitudes, in place: bin k overwrites index k <= 2k.
+   * Here a centered sine of amplitude A reads 16.A (8.A with
+   * the Hann gain of 1/2) and the mean D reads 32.D */
+  for(k = 0; k < m; k++)
+  {
+    tr  = block[2*k];
+    ti  = block[2*k + 1];
+    val = MMA7455_isqrt((uint32_t)(tr * tr) + (uint32_t)(ti * ti));
+    if(this->_window == fft_hann)   val <<= 1;
+    if(k == 0)                      val >>= 1;
+    mags[k] = (uint16_t)val;
+  }
+  return mags;
+}
+
+uint8_t MMA7455_FFT::getPeaks(const uint16_t* mags, MMA7455_PEAK* peaks, uint8_t count)
+{
+  uint16_t m     = this->_n >> 1;
+  uint16_t k     = 0;
+  uint8_t  found = 0;
+  uint8_t  i     = 0;
+  
+  if(mags == NULL || peaks == NULL || count == 0)   return 0;
+  
+  /* local maxima past the DC lobe (one more bin with
+   * Hann), kept sorted by magnitude */
+  for(k = (this->_window == fft_hann) ? 2 : 1; k < m; k++)
+  {
+    if(mags[k] == 0 || mags[k] < mags[k - 1] ||
+       (k + 1 < m && mags[k] <= mags[k + 1]))
+    {
+      continue;
+    }
+    if(found == count && mags[k] <= peaks[count - 1].mag)   continue;
+    
+    i = (found < count) ? found++ : count - 1;
+    for(; i > 0 && peaks[i - 1].mag < mags[k]; i--)
+    {
+      peaks[i] = peaks[i - 1];
+    }
+    peaks[i].bin = k;
+    peaks[i].mag = mags[k];
+  }
+  return found;
+}
+
+int16_t MMA7455_FFT::_sin(uint16_t idx)
+{
+  /* idx: 1024 points on the circle */
+  idx &= 1023;
+  if(idx < 256)   return  (int16_t)pgm_read_word(&mma7455_sin_q15[idx]);
+  if(idx < 512)   return  (int16_t)pgm_read_word(&mma7455_sin_q15[512 - idx]);
+  if(idx < 768)   return -(int16_t)pgm_read_word(&mma7455_sin_q15[idx - 512]);
+  return -(int16_t)pgm_read_word(&mma7455_sin_q15[1024 - idx]);
+}
+
+int16_t MMA7455_FFT::_cos(uint16_t idx)
+{
+  return this->_sin(idx + 256);
+}
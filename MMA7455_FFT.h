@@ -0,0 +1,78 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_FFT
+ *  Desc.:     Fixed-point real FFT of sample blocks
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    The transform runs in place on one axis block of n 10-bit
+ *    samples (n power of 2, 16 to 512): the samples are windowed,
+ *    packed as n/2 complex values for a radix-2 FFT, then split
+ *    into the n/2 bins of the real spectrum. No heap, no copy.
+ *
+ *    On return the block holds n/2 magnitudes, bin k being at
+ *    k * fs / n. A bin reads the amplitude of a sine centered on
+ *    it, 1 = 1/16 count (the window gain is compensated); bin 0
+ *    reads the mean.
+ *
+ */
+
+#ifndef __MMA7455_FFT_H__
+#define __MMA7455_FFT_H__
+
+#include "MMA_7455.h"
+
+#define MMA7455_FFT_MIN         (16)
+#define MMA7455_FFT_MAX         (512)
+
+/* Window */
+typedef enum _FFT_WINDOW
+{
+  fft_rectangular = 0,
+  fft_hann        = 1
+} FFT_WINDOW;
+
+/* Spectral peak */
+typedef struct _MMA7455_PEAK
+{
+  uint16_t bin;
+  uint16_t mag;    /* 1 = 1/16 count */
+} MMA7455_PEAK;
+
+class MMA7455_FFT
+{
+  public:
+    MMA7455_FFT(uint16_t n, FFT_WINDOW window);
+    
+    uint16_t getSize(void);
+    uint16_t* transform(int16_t* block);
+    uint8_t getPeaks(const uint16_t* mags, MMA7455_PEAK* peaks, uint8_t count);
+  
+  private:
+    uint16_t   _n;
+    uint8_t    _log2;
+    FFT_WINDOW _window;
+    
+    int16_t _sin(uint16_t idx);
+    int16_t _cos(uint16_t idx);
+};
+
+#endif /* __MMA7455_FFT_H__ */
@@ -0,0 +1,208 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_FallDetector.h"
+
+MMA7455_FallDetector::MMA7455_FallDetector(void)
+{
+  /* 0.3g for 100 ms, 2.5g within 1 s, 1g +/-0.15g for 1 s */
+  this->setFreeFall(19, 100);
+  this->setImpact(160, 1000);
+  this->setRest(10, 1000, 10000);
+  this->reset();
+}
+
+void MMA7455_FallDetector::setFreeFall(uint16_t threshold, uint16_t min_ms)
+{
+  this->_ff_sq     = (uint32_t)threshold * threshold;
+  this->_ff_min_us = (uint32_t)min_ms * 1000UL;
+  return;
+}
+
+void MMA7455_FallDetector::setImpact(uint16_t threshold, uint16_t window_ms)
+{
+  this->_impact_sq = (uint32_t)threshold * threshold;
+  this->_window_us = (uint32_t)window_ms * 1000UL;
+  return;
+}
+
+void MMA7455_FallDetector::setRest(uint16_t band, uint16_t min_ms, uint16_t timeout_ms)
+{
+  uint16_t lo = (band < MMA7455_FALL_ONE_G) ? MMA7455_FALL_ONE_G - band : 0;
+  uint16_t hi = MMA7455_FALL_ONE_G + band;
+  
+  this->_rest_lo_sq  = (uint32_t)lo * lo;
+  this->_rest_hi_sq  = (uint32_t)hi * hi;
+  this->_rest_min_us = (uint32_t)min_ms * 1000UL;
+  this->_rest_max_us = (uint32_t)timeout_ms * 1000UL;
+  return;
+}
+
+void MMA7455_FallDetector::reset(void)
+{
+  this->_state   = fall_idle;
+  this->_start   = 0;
+  this->_last    = 0;
+  this->_peak_sq = 0;
+  this->_in_band = false;
+  memset(&this->_event, 0, sizeof(this->_event));
+  return;
+}
+
+FALL_EVENT MMA7455_FallDetector::add(const MMA7455_SAMPLE* sample)
+{
+  uint32_t mag_sq = 0;
+  uint32_t now    = 0;
+  uint32_t start  = 0;
+  
+  if(sample == NULL)  return fall_none;
+  
+  /* 10-bit squares: at most 3 * 512^2 */
+  now    = sample->time;
+  mag_sq = (uint32_t)((int32_t)sample->x * sample->x) +
+           (uint32_t)((int32_t)sample->y * sample->y) +
+           (uint32_t)((int32_t)sample->z * sample->z);
+  
+  switch(this->_state)
+  {
+    case fall_idle:
+      if(mag_sq < this->_ff_sq)
+      {
+        this->_start = now;
+        this->_state = fall_falling;
+      }
+      break;
+    
+    case fall_falling:
+      if(mag_sq >= this->_ff_sq)
+      {
+        this->_state = fall_idle;
+      }
+      else if(now - this->_start >= this->_ff_min_us)
+      {
+        this->_last  = now;
+        this->_state = fall_freefall;
+        return this->_emit(fall_freefall_event, this->_start, now - this->_start);
+      }
+      break;
+    
+    case fall_freefall:
+      if(mag_sq > this->_impact_sq)
+      {
+        this->_start   = now;
+        this->_peak_sq = mag_sq;
+        this->_state   = fall_impact;
+      }
+      else if(mag_sq < this->_ff_sq)
+      {
+        this->_last = now;
+      }
+      else if(now - this->_last > this->_window_us)
+      {
+        /* no impact after the fall */
+        start        = this->_last;
+        this->_state = fall_idle;
+        return this->_emit(fall_timeout_event, start, now - start);
+      }
+      break;
+    
+    case fall_impact:
+      if(mag_sq > this->_impact_sq)
+      {
+        if(mag_sq > this->_peak_sq)   this->_peak_sq = mag_sq;
+        if(now - this->_start > this->_window_us)
+        {
+          /* sustained, not a shock: ends with its peak */
+          start        = this->_start;
+          this->_state = fall_idle;
+          this->_emit(fall_timeout_event, start, now - start);
+          this->_event.peak = MMA7455_isqrt(this->_peak_sq);
+          return fall_timeout_event;
+        }
+      }
+      else
+      {
+        /* end of the spike */
+        start          = this->_start;
+        this->_last    = now;
+        this->_in_band = false;
+        this->_state   = fall_settling;
+        this->_emit(fall_impact_event, start, now - start);
+        this->_event.peak = MMA7455_isqrt(this->_peak_sq);
+        return fall_impact_event;
+      }
+      break;
+    
+    case fall_settling:
+      if(mag_sq >= this->_rest_lo_sq && mag_sq <= this->_rest_hi_sq)
+      {
+        if(!this->_in_band)
+        {
+          this->_in_band = true;
+          this->_start   = now;
+        }
+        else if(now - this->_start >= this->_rest_min_us)
+        {
+          start        = this->_start;
+          this->_state = fall_idle;
+          return this->_emit(fall_rest_event, start, now - start);
+        }
+      }
+      else
+      {
+        this->_in_band = false;
+      }
+      if(this->_rest_max_us != 0 && now - this->_last > this->_rest_max_us)
+      {
+        /* still moving after the impact */
+        start        = this->_last;
+        this->_state = fall_idle;
+        return this->_emit(fall_timeout_event, start, now - start);
+      }
+      break;
+  }
+  return fall_none;
+}
+
+FALL_EVENT MMA7455_FallDetector::acquire(MMA_7455* accel, MMA7455_SAMPLE* sample)
+{
+  if(accel == NULL || sample == NULL)   return fall_none;
+  if(!accel->readSample(sample))  return fall_none;
+  return this->add(sample);
+}
+
+FALL_STATE MMA7455_FallDetector::getState(void)
+{
+  return this->_state;
+}
+
+void MMA7455_FallDetector::getEvent(MMA7455_FALL* event)
+{
+  if(event)   *event = this->_event;
+  return;
+}
+
+FALL_EVENT MMA7455_FallDetector::_emit(FALL_EVENT event, uint32_t time, uint32_t duration)
+{
+  this->_event.event    = event;
+  this->_event.time     = time;
+  this->_event.duration = duration;
+  this->_event.peak     = 0;
+  return event;
+}
@@ -0,0 +1,116 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_FallDetector
+ *  Desc.:     Free fall, impact and rest detection on the
+ *             10-bit sample stream
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    The vector magnitude is compared squared, no square root
+ *    per sample. Magnitudes are in 10-bit counts (64 = 1g).
+ *
+ *    A free fall is a magnitude under the free fall threshold
+ *    for a minimum time. An impact is a spike over the impact
+ *    threshold within the impact window after the free fall;
+ *    its event is emitted at the end of the spike, with the
+ *    peak. Rest is the magnitude staying within a band around
+ *    1g for a minimum time after the impact. A sequence that
+ *    does not complete in time ends with a timeout event: no
+ *    impact within the impact window, a spike lasting longer
+ *    than the impact window (with its peak), or no rest before
+ *    the rest timeout.
+ *
+ *    The detector only works on samples already read for the
+ *    measurement, it adds no bus access.
+ *
+ */
+
+#ifndef __MMA7455_FALLDETECTOR_H__
+#define __MMA7455_FALLDETECTOR_H__
+
+#include "MMA_7455.h"
+
+#define MMA7455_FALL_ONE_G  (64)    /* 10-bit counts */
+
+/* Detector state */
+typedef enum _FALL_STATE
+{
+  fall_idle = 0,
+  fall_falling,    /* under the threshold, not long enough yet */
+  fall_freefall,   /* free fall confirmed, waiting for impact */
+  fall_impact,     /* in the impact spike */
+  fall_settling    /* after the impact, waiting for rest */
+} FALL_STATE;
+
+/* Detector events */
+typedef enum _FALL_EVENT
+{
+  fall_none = 0,
+  fall_freefall_event,
+  fall_impact_event,
+  fall_rest_event,
+  fall_timeout_event
+} FALL_EVENT;
+
+typedef struct _MMA7455_FALL
+{
+  FALL_EVENT event;
+  uint32_t   time;      /* start of the phase, 1 = 1 us */
+  uint32_t   duration;  /* phase length, 1 = 1 us */
+  uint16_t   peak;      /* impact peak magnitude, 1 = 1 count */
+} MMA7455_FALL;
+
+class MMA7455_FallDetector
+{
+  public:
+    MMA7455_FallDetector(void);
+    
+    void    setFreeFall(uint16_t threshold, uint16_t min_ms);
+    void    setImpact(uint16_t threshold, uint16_t window_ms);
+    void    setRest(uint16_t band, uint16_t min_ms, uint16_t timeout_ms);
+    void    reset(void);
+    
+    FALL_EVENT add(const MMA7455_SAMPLE* sample);
+    FALL_EVENT acquire(MMA_7455* accel, MMA7455_SAMPLE* sample);
+    FALL_STATE getState(void);
+    void    getEvent(MMA7455_FALL* event);
+  
+  private:
+    uint32_t _ff_sq;        /* squared thresholds */
+    uint32_t _impact_sq;
+    uint32_t _rest_lo_sq;
+    uint32_t _rest_hi_sq;
+    uint32_t _ff_min_us;
+    uint32_t _window_us;
+    uint32_t _rest_min_us;
+    uint32_t _rest_max_us;  /* 0 = no timeout */
+    
+    FALL_STATE _state;
+    uint32_t _start;        /* start of the current phase */
+    uint32_t _last;         /* last free fall / in band sample */
+    uint32_t _peak_sq;
+    bool     _in_band;
+    MMA7455_FALL _event;
+    
+    FALL_EVENT _emit(FALL_EVENT event, uint32_t time, uint32_t duration);
+};
+
+#endif /* __MMA7455_FALLDETECTOR_H__ */
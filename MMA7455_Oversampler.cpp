@@ -0,0 +1,119 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_Oversampler.h"
+
+MMA7455_Oversampler::MMA7455_Oversampler(MMA_7455* accel)
+{
+  this->_accel = accel;
+  this->_log2  = 0;
+  memset(this->_out, 0, sizeof(this->_out));
+  memset(this->_noise, 0, sizeof(this->_noise));
+  this->reset();
+}
+
+void MMA7455_Oversampler::setOversampling(uint8_t n)
+{
+  this->_log2 = (n > MMA7455_OS_MAX) ? MMA7455_OS_MAX : n;
+  this->reset();
+  return;
+}
+
+uint8_t MMA7455_Oversampler::getOversampling(void)
+{
+  return this->_log2;
+}
+
+uint8_t MMA7455_Oversampler::getFractionalBits(void)
+{
+  return this->_log2 >> 1;
+}
+
+void MMA7455_Oversampler::reset(void)
+{
+  this->_count = 0;
+  memset(this->_sum, 0, sizeof(this->_sum));
+  memset(this->_sumsq, 0, sizeof(this->_sumsq));
+  return;
+}
+
+bool MMA7455_Oversampler::readAxis10(int32_t* x, int32_t* y, int32_t* z)
+{
+  int16_t val[3] = {0};
+  
+  /* one fresh conversion per call at most */
+  if(this->_accel == NULL ||
+     !this->_accel->readSample10(&val[0], &val[1], &val[2]))
+  {
+    return false;
+  }
+  if(!this->add(val[0], val[1], val[2]))  return false;
+  
+  if(x) *x = this->_out[0];
+  if(y) *y = this->_out[1];
+  if(z) *z = this->_out[2];
+  return true;
+}
+
+bool MMA7455_Oversampler::add(int16_t x, int16_t y, int16_t z)
+{
+  int16_t  val[3] = {x, y, z};
+  uint8_t  shift  = this->_log2 - (this->_log2 >> 1);
+  uint32_t n      = (uint32_t)1 << this->_log2;
+  int64_t  num    = 0;
+  uint8_t  i      = 0;
+  
+  /* 2^8 samples of 10 bits fit both sums in 32 bits */
+  for(i = 0; i < 3; i++)
+  {
+    this->_sum[i]   += val[i];
+    this->_sumsq[i] += (int32_t)val[i] * val[i];
+  }
+  if(++this->_count < n)    return false;
+  
+  for(i = 0; i < 3; i++)
+  {
+    /* decimate, keeping n/2 fractional bits (rounded) */
+    this->_out[i] = (this->_sum[i] + ((int32_t)1 << shift >> 1)) >> shift;
+    
+    /* standard error of the mean, 1/256 count:
+     * sqrt(var / n) with var = (n.sumsq - sum^2) / (n.(n-1)) */
+    if(n > 1)
+    {
+      num  = (int64_t)n * this->_sumsq[i] - (int64_t)this->_sum[i] * this->_sum[i];
+      num  = (num << 16) / ((int64_t)n * n * (n - 1));
+      num  = MMA7455_isqrt(num > 0 ? num : 0);
+      this->_noise[i] = (num > 0xFFFF) ? 0xFFFF : (uint16_t)num;
+    }
+    else
+    {
+      this->_noise[i] = 0;
+    }
+  }
+  this->reset();
+  return true;
+}
+
+void MMA7455_Oversampler::getNoiseFloor(uint16_t* x, uint16_t* y, uint16_t* z)
+{
+  if(x) *x = this->_noise[0];
+  if(y) *y = this->_noise[1];
+  if(z) *z = this->_noise[2];
+  return;
+}
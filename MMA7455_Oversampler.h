@@ -0,0 +1,65 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_Oversampler
+ *  Desc.:     Oversampling and decimation of the 10-bit outputs
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Accumulates 2^n fresh (DRDY gated) samples and emits one
+ *    decimated sample with n/2 extra fractional bits: the output
+ *    rate drops by 2^n, the white noise by 2^(n/2).
+ *    The output is a 10-bit value scaled by 2^(n/2), e.g. with
+ *    n = 4 a 1g reading (64 counts) reads 256.
+ *
+ */
+
+#ifndef __MMA7455_OVERSAMPLER_H__
+#define __MMA7455_OVERSAMPLER_H__
+
+#include "MMA_7455.h"
+
+#define MMA7455_OS_MAX          (8)
+
+class MMA7455_Oversampler
+{
+  public:
+    MMA7455_Oversampler(MMA_7455* accel);
+    
+    void    setOversampling(uint8_t n);   /* 2^n samples, n in [0; 8] */
+    uint8_t getOversampling(void);
+    uint8_t getFractionalBits(void);
+    void    reset(void);
+    
+    bool    readAxis10(int32_t* x, int32_t* y, int32_t* z);
+    bool    add(int16_t x, int16_t y, int16_t z);
+    void    getNoiseFloor(uint16_t* x, uint16_t* y, uint16_t* z); /* 1 = 1/256 count */
+  
+  private:
+    MMA_7455* _accel;
+    uint8_t  _log2;
+    uint16_t _count;
+    int32_t  _sum[3];
+    uint32_t _sumsq[3];
+    int32_t  _out[3];
+    uint16_t _noise[3];
+};
+
+#endif /* __MMA7455_OVERSAMPLER_H__ */
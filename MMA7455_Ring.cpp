@@ -0,0 +1,202 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_Ring.h"
+
+/* keep the compiler (and the CPU on hosts) from
+ * reordering the slot accesses around the sequence */
+#if defined(__GNUC__) && !defined(__AVR__)
+#define MMA7455_BARRIER()   __sync_synchronize()
+#else
+#define MMA7455_BARRIER()   __asm__ __volatile__("" ::: "memory")
+#endif
+
+MMA7455_Ring::MMA7455_Ring(void)
+{
+  this->_header = NULL;
+  this->_slots  = NULL;
+  this->_mask   = 0;
+}
+
+bool MMA7455_Ring::begin(void* mem, uint32_t size)
+{
+  uint32_t slots = 0;
+  uint16_t i     = 0;
+  
+  if(mem == NULL || size < MMA7455_RING_SIZE(2))  return false;
+  
+  /* largest power of 2 that fits */
+  slots = (size - sizeof(MMA7455_RING_HEADER)) / sizeof(MMA7455_RING_SLOT);
+  if(slots > 0x8000)    slots = 0x8000;
+  for(i = 1; (uint32_t)i << 1 <= slots; i <<= 1);
+  
+  this->_header = (MMA7455_RING_HEADER*)mem;
+  this->_slots  = (MMA7455_RING_SLOT*)(this->_header + 1);
+  this->_mask   = i - 1;
+  
+  memset(mem, 0, MMA7455_RING_SIZE(i));
+  this->_header->slots     = i;
+  this->_header->slot_size = sizeof(MMA7455_RING_SLOT);
+  this->_header->head      = 0;
+  MMA7455_BARRIER();
+  /* published last: readers attach only to a formatted ring */
+  this->_header->magic     = MMA7455_RING_MAGIC;
+  return true;
+}
+
+bool MMA7455_Ring::attach(void* mem, uint32_t size)
+{
+  MMA7455_RING_HEADER* header = (MMA7455_RING_HEADER*)mem;
+  
+  if(mem == NULL || size < sizeof(MMA7455_RING_HEADER))   return false;
+  if(header->magic != MMA7455_RING_MAGIC ||
+     header->slot_size != sizeof(MMA7455_RING_SLOT) ||
+     header->slots == 0 || (header->slots & (header->slots - 1)) ||
+     size < MMA7455_RING_SIZE(header->slots))
+  {
+    return false;
+  }
+  
+  this->_header = header;
+  this->_slots  = (MMA7455_RING_SLOT*)(header + 1);
+  this->_mask   = header->slots - 1;
+  return true;
+}
+
+uint16_t MMA7455_Ring::getSlots(void)
+{
+  return this->_header ? this->_header->slots : 0;
+}
+
+uint32_t MMA7455_Ring::getHead(void)
+{
+  return this->_header ? this->_load(&this->_header->head) : 0;
+}
+
+void MMA7455_Ring::push(const MMA7455_SAMPLE* sample)
+{
+  MMA7455_RING_SLOT* slot = NULL;
+  uint32_t           seq  = 0;
+  
+  if(this->_header == NULL || sample == NULL)   return;
+  
+  /* single writer: head is only ever written here */
+  seq  = this->_header->head;
+  slot = &this->_slots[seq & this->_mask];
+  
+  slot->seq = (seq << 1) | 1;
+  MMA7455_BARRIER();
+  slot->sample = *sample;
+  MMA7455_BARRIER();
+  slot->seq = (seq << 1) + 2;
+  MMA7455_BARRIER();
+  this->_header->head = seq + 1;
+  return;
+}
+
+bool MMA7455_Ring::acquire(MMA_7455* accel)
+{
+  MMA7455_SAMPLE sample;
+  
+  if(accel == NULL || !accel->readSample(&sample))  return false;
+  this->push(&sample);
+  return true;
+}
+
+void MMA7455_Ring::openReader(MMA7455_RING_READER* reader)
+{
+  if(reader == NULL)    return;
+  reader->next = this->getHead();
+  reader->lost = 0;
+  return;
+}
+
+const MMA7455_SAMPLE* MMA7455_Ring::peek(MMA7455_RING_READER* reader)
+{
+  MMA7455_RING_SLOT* slot = NULL;
+  uint32_t           head = 0;
+  
+  if(this->_header == NULL || reader == NULL)   return NULL;
+  
+  head = this->getHead();
+  if(head == reader->next)  return NULL;
+  
+  /* lapped by the writer: skip to the oldest slot left */
+  if(head - reader->next > this->_header->slots)
+  {
+    reader->lost += head - reader->next - this->_header->slots;
+    reader->next  = head - this->_header->slots;
+  }
+  
+  slot = &this->_slots[reader->next & this->_mask];
+  if(this->_load(&slot->seq) != (reader->next << 1) + 2)
+  {
+    /* overwritten in the meantime, the next peek catches up */
+    reader->lost++;
+    reader->next++;
+    return NULL;
+  }
+  MMA7455_BARRIER();
+  return &slot->sample;
+}
+
+bool MMA7455_Ring::release(MMA7455_RING_READER* reader)
+{
+  MMA7455_RING_SLOT* slot = NULL;
+  bool               valid = false;
+  
+  if(this->_header == NULL || reader == NULL)   return false;
+  
+  /* the sample read in place is valid only if
+   * its slot was not reused while being read */
+  MMA7455_BARRIER();
+  slot  = &this->_slots[reader->next & this->_mask];
+  valid = this->_load(&slot->seq) == (reader->next << 1) + 2;
+  if(!valid)    reader->lost++;
+  reader->next++;
+  return valid;
+}
+
+bool MMA7455_Ring::read(MMA7455_RING_READER* reader, MMA7455_SAMPLE* sample)
+{
+  const MMA7455_SAMPLE* slot = NULL;
+  
+  if(sample == NULL)    return false;
+  while((slot = this->peek(reader)) != NULL)
+  {
+    *sample = *slot;
+    if(this->release(reader))   return true;
+  }
+  return false;
+}
+
+uint32_t MMA7455_Ring::_load(const volatile uint32_t* val)
+{
+  uint32_t a = *val;
+  uint32_t b = *val;
+  
+  /* 8-bit cores read 32 bits in several accesses,
+   * re-read until no write slipped in between */
+  while(a != b)
+  {
+    a = b;
+    b = *val;
+  }
+  return a;
+}
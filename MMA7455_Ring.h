@@ -0,0 +1,97 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_Ring
+ *  Desc.:     Lock-free ring of timestamped samples, one
+ *             writer and any number of readers
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    The ring lives in a caller provided memory block made
+ *    of a header and a power of 2 number of slots. It holds
+ *    no pointer, so the block can be shared between processes
+ *    (e.g. a file mapped from /dev/shm on a Linux host) or
+ *    between an interrupt and the main loop on a board.
+ *
+ *    Every sample gets a sequence number. A reader keeps its
+ *    own cursor and detects the samples it missed when the
+ *    writer laps it, and the slots overwritten while it was
+ *    reading them in place.
+ *
+ */
+
+#ifndef __MMA7455_RING_H__
+#define __MMA7455_RING_H__
+
+#include "MMA_7455.h"
+
+#define MMA7455_RING_MAGIC      (0x4D413535UL)
+
+/* Bytes needed for a ring of n slots */
+#define MMA7455_RING_SIZE(n)    (sizeof(MMA7455_RING_HEADER) + \
+                                 (n) * sizeof(MMA7455_RING_SLOT))
+
+typedef struct _MMA7455_RING_HEADER
+{
+  uint32_t magic;
+  uint16_t slots;
+  uint16_t slot_size;
+  volatile uint32_t head;     /* sequence of the next sample */
+} MMA7455_RING_HEADER;
+
+typedef struct _MMA7455_RING_SLOT
+{
+  volatile uint32_t seq;      /* 2*n+1 while written, 2*n+2 once valid */
+  MMA7455_SAMPLE    sample;
+} MMA7455_RING_SLOT;
+
+typedef struct _MMA7455_RING_READER
+{
+  uint32_t next;              /* sequence expected next */
+  uint32_t lost;              /* samples overwritten before being read */
+} MMA7455_RING_READER;
+
+class MMA7455_Ring
+{
+  public:
+    MMA7455_Ring(void);
+    
+    bool    begin(void* mem, uint32_t size);
+    bool    attach(void* mem, uint32_t size);
+    uint16_t getSlots(void);
+    uint32_t getHead(void);
+    
+    void    push(const MMA7455_SAMPLE* sample);
+    bool    acquire(MMA_7455* accel);
+    
+    void    openReader(MMA7455_RING_READER* reader);
+    const MMA7455_SAMPLE* peek(MMA7455_RING_READER* reader);
+    bool    release(MMA7455_RING_READER* reader);
+    bool    read(MMA7455_RING_READER* reader, MMA7455_SAMPLE* sample);
+  
+  private:
+    MMA7455_RING_HEADER* _header;
+    MMA7455_RING_SLOT*   _slots;
+    uint16_t _mask;
+    
+    uint32_t _load(const volatile uint32_t* val);
+};
+
+#endif /* __MMA7455_RING_H__ */
@@ -0,0 +1,136 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_Stats.h"
+
+MMA7455_Stats::MMA7455_Stats(void)
+{
+  this->_window = 0;
+  this->_mode   = stats_tumbling;
+  memset(&this->_record, 0, sizeof(this->_record));
+  memset(this->_acc, 0, sizeof(this->_acc));
+}
+
+bool MMA7455_Stats::begin(uint16_t window, STATS_MODE mode)
+{
+  if(window == 0 || window > MMA7455_STATS_MAX_WINDOW)  return false;
+  if(mode == stats_sliding && window < 2)   return false;
+  
+  this->_window = window;
+  this->_mode   = mode;
+  this->reset();
+  return true;
+}
+
+void MMA7455_Stats::reset(void)
+{
+  uint8_t i = 0;
+  
+  for(i = 0; i < MMA7455_STATS_PHASES; i++)
+  {
+    /* sliding: phase i starts i/PHASES of a window later */
+    if(this->_mode == stats_sliding)
+      this->_clear(&this->_acc[i], -(int16_t)(i * this->_window / MMA7455_STATS_PHASES));
+    else
+      this->_clear(&this->_acc[i], i == 0 ? 0 : -1);
+  }
+  return;
+}
+
+bool MMA7455_Stats::add(const MMA7455_SAMPLE* sample)
+{
+  ACCUMULATOR* acc   = NULL;
+  int16_t      val[3];
+  uint16_t     mag   = 0;
+  bool         ready = false;
+  uint8_t      i     = 0;
+  uint8_t      j     = 0;
+  
+  if(sample == NULL || this->_window == 0)  return false;
+  
+  val[0] = sample->x;
+  val[1] = sample->y;
+  val[2] = sample->z;
+  
+  for(i = 0; i < MMA7455_STATS_PHASES; i++)
+  {
+    acc = &this->_acc[i];
+    if(acc->count < 0)
+    {
+      /* tumbling mode only runs the first accumulator */
+      if(this->_mode == stats_sliding)  acc->count++;
+      continue;
+    }
+    
+    if(acc->count == 0)   acc->start = sample->time;
+    acc->end = sample->time;
+    for(j = 0; j < 3; j++)
+    {
+      mag = (val[j] < 0) ? -val[j] : val[j];
+      acc->sum[j]   += val[j];
+      acc->sumsq[j] += (uint32_t)mag * mag;
+      if(mag > acc->peak[j])  acc->peak[j] = mag;
+    }
+    
+    if(++acc->count >= (int16_t)this->_window)
+    {
+      this->_finish(acc);
+      this->_clear(acc, 0);
+      ready = true;
+    }
+  }
+  return ready;
+}
+
+void MMA7455_Stats::getRecord(MMA7455_STATS* record)
+{
+  if(record)  *record = this->_record;
+  return;
+}
+
+void MMA7455_Stats::_clear(ACCUMULATOR* acc, int16_t delay)
+{
+  memset(acc, 0, sizeof(ACCUMULATOR));
+  acc->count = delay;
+  return;
+}
+
+void MMA7455_Stats::_finish(ACCUMULATOR* acc)
+{
+  MMA7455_STATS* rec = &this->_record;
+  int64_t        n   = acc->count;
+  int64_t        num = 0;
+  uint8_t        j   = 0;
+  
+  rec->start = acc->start;
+  rec->end   = acc->end;
+  rec->count = acc->count;
+  for(j = 0; j < 3; j++)
+  {
+    /* exact integer sums: no cancellation in n.sumsq - sum^2 */
+    num = n * acc->sumsq[j] - (int64_t)acc->sum[j] * acc->sum[j];
+    rec->variance[j] = (uint32_t)((num << 8) / (n * n));
+    rec->mean[j]     = (int16_t)(((int64_t)acc->sum[j] * 16) / n);
+    rec->rms[j]      = (uint16_t)MMA7455_isqrt(((uint64_t)acc->sumsq[j] << 8) / n);
+    rec->peak[j]     = acc->peak[j];
+    num = rec->rms[j] ? ((uint32_t)acc->peak[j] << 12) / rec->rms[j] : 0;
+    rec->crest[j]    = (num > 0xFFFF) ? 0xFFFF : (uint16_t)num;
+  }
+  return;
+}
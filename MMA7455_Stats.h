@@ -0,0 +1,96 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_Stats
+ *  Desc.:     Streaming per-axis statistics over fixed windows
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Samples are folded into exact integer running sums, no
+ *    sample is buffered: memory does not depend on the window
+ *    length. Once a window is complete, a record with mean,
+ *    variance, RMS, peak and crest factor per axis is ready.
+ *
+ *    Tumbling windows are back to back. Sliding windows overlap
+ *    by half: two staggered accumulators emit a record every
+ *    half window, each covering a full window.
+ *
+ */
+
+#ifndef __MMA7455_STATS_H__
+#define __MMA7455_STATS_H__
+
+#include "MMA_7455.h"
+
+/* 10-bit squares of a full window fit in 32 bits */
+#define MMA7455_STATS_MAX_WINDOW  (16383)
+#define MMA7455_STATS_PHASES      (2)
+
+/* Window mode */
+typedef enum _STATS_MODE
+{
+  stats_tumbling = 0,
+  stats_sliding  = 1
+} STATS_MODE;
+
+/* Statistics of one window */
+typedef struct _MMA7455_STATS
+{
+  uint32_t start;        /* first sample time, 1 = 1 us */
+  uint32_t end;          /* last sample time, 1 = 1 us */
+  uint16_t count;
+  int16_t  mean[3];      /* 1 = 1/16 count */
+  uint32_t variance[3];  /* 1 = 1/256 count^2 */
+  uint16_t rms[3];       /* 1 = 1/16 count */
+  uint16_t peak[3];      /* max |value|, 1 = 1 count */
+  uint16_t crest[3];     /* peak / rms, 1 = 1/256 */
+} MMA7455_STATS;
+
+class MMA7455_Stats
+{
+  public:
+    MMA7455_Stats(void);
+    
+    bool    begin(uint16_t window, STATS_MODE mode);
+    void    reset(void);
+    bool    add(const MMA7455_SAMPLE* sample);
+    void    getRecord(MMA7455_STATS* record);
+  
+  private:
+    typedef struct _ACCUMULATOR
+    {
+      uint32_t start;
+      uint32_t end;
+      int16_t  count;     /* < 0 while waiting for its turn */
+      int32_t  sum[3];
+      uint32_t sumsq[3];
+      uint16_t peak[3];
+    } ACCUMULATOR;
+    
+    ACCUMULATOR   _acc[MMA7455_STATS_PHASES];
+    MMA7455_STATS _record;
+    uint16_t      _window;
+    STATS_MODE    _mode;
+    
+    void    _clear(ACCUMULATOR* acc, int16_t delay);
+    void    _finish(ACCUMULATOR* acc);
+};
+
+#endif /* __MMA7455_STATS_H__ */
@@ -0,0 +1,168 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MMA7455_Trigger.h"
+
+MMA7455_Trigger::MMA7455_Trigger(MMA7455_SAMPLE* buff, uint16_t size)
+{
+  this->_buff      = buff;
+  this->_size      = (buff != NULL) ? size : 0;
+  this->_pre       = 0;
+  this->_post      = 0;
+  this->_threshold = 0;
+  this->_int_pin   = -1;
+  this->_pending   = false;
+  this->_detsrc    = 0;
+  this->_state     = trig_idle;
+  this->_head      = 0;
+  this->_filled    = 0;
+  this->_start     = 0;
+  memset(&this->_capture, 0, sizeof(this->_capture));
+}
+
+bool MMA7455_Trigger::begin(uint16_t pre, uint16_t post)
+{
+  if(post == 0 || (uint32_t)pre + post > this->_size)   return false;
+  this->_pre   = pre;
+  this->_post  = post;
+  this->_state = trig_idle;
+  return true;
+}
+
+void MMA7455_Trigger::setThreshold(uint16_t level)
+{
+  this->_threshold = level;
+  return;
+}
+
+void MMA7455_Trigger::setInterruptPin(uint8_t pin)
+{
+  this->_int_pin = pin;
+#if !defined(MMA7455_HOST)
+  pinMode(this->_int_pin, INPUT);
+#endif
+  return;
+}
+
+void MMA7455_Trigger::arm(MMA_7455* accel)
+{
+  if(this->_post == 0)  return;
+  /* an event latched before arming is not a trigger */
+  if(accel)   accel->clearInterrupt();
+  this->_head    = 0;
+  this->_filled  = 0;
+  this->_start   = 0;
+  this->_pending = false;
+  this->_detsrc  = 0;
+  memset(&this->_capture, 0, sizeof(this->_capture));
+  this->_state   = trig_armed;
+  return;
+}
+
+TRIGGER_STATE MMA7455_Trigger::getState(void)
+{
+  return this->_state;
+}
+
+void MMA7455_Trigger::trigger(uint8_t detsrc)
+{
+  /* safe from an ISR: taken on the next sample */
+  if(this->_state != trig_armed)  return;
+  this->_detsrc  = detsrc;
+  this->_pending = true;
+  return;
+}
+
+bool MMA7455_Trigger::add(const MMA7455_SAMPLE* sample)
+{
+  uint16_t level = this->_threshold;
+  bool     fire  = false;
+  
+  if(sample == NULL || this->_state == trig_idle ||
+     this->_state == trig_done)
+  {
+    return false;
+  }
+  
+  this->_buff[this->_head] = *sample;
+  if(++this->_head >= this->_size)  this->_head = 0;
+  
+  if(this->_state == trig_armed)
+  {
+    fire = this->_pending;
+    if(!fire && level > 0)
+    {
+      fire = sample->x >= (int16_t)level || sample->x <= -(int16_t)level ||
+             sample->y >= (int16_t)level || sample->y <= -(int16_t)level ||
+             sample->z >= (int16_t)level || sample->z <= -(int16_t)level;
+    }
+    if(!fire)
+    {
+      /* keep only the pre-trigger history */
+      if(this->_filled < this->_pre)  this->_filled++;
+      return false;
+    }
+    
+    /* freeze the history, this sample is the first post one */
+    this->_capture.time   = sample->time;
+    this->_capture.detsrc = this->_pending ? this->_detsrc : 0;
+    this->_capture.pre    = this->_filled;
+    this->_capture.post   = 0;
+    this->_start  = (this->_head + 2 * this->_size - 1 - this->_filled) % this->_size;
+    this->_state  = trig_post;
+  }
+  
+  if(++this->_capture.post >= this->_post)
+  {
+    this->_state = trig_done;
+    return true;
+  }
+  return false;
+}
+
+bool MMA7455_Trigger::acquire(MMA_7455* accel)
+{
+  MMA7455_SAMPLE sample;
+  
+  if(accel == NULL || !accel->readSample(&sample))  return false;
+  
+#if !defined(MMA7455_HOST)
+  /* DETSRC read only once the detection raised the pin */
+  if(this->_state == trig_armed && !this->_pending &&
+     this->_int_pin >= 0 && digitalRead(this->_int_pin) == HIGH)
+  {
+    this->trigger(accel->getDetectionSource());
+    accel->clearInterrupt();
+  }
+#endif
+  return this->add(&sample);
+}
+
+void MMA7455_Trigger::getCapture(MMA7455_CAPTURE* capture)
+{
+  if(capture)   *capture = this->_capture;
+  return;
+}
+
+const MMA7455_SAMPLE* MMA7455_Trigger::getSample(uint16_t i)
+{
+  if(this->_state != trig_done && this->_state != trig_post)  return NULL;
+  if(i >= this->_capture.pre + this->_capture.post)   return NULL;
+  return &this->_buff[(this->_start + i) % this->_size];
+}
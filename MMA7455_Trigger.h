@@ -0,0 +1,98 @@
+/**
+ *   Freescale 3-Axis Accelerometer MMA7455 Library designed for Arduino
+ *   Copyright (C) 2015  Alexandre Boni
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License along
+ *   with this program; if not, write to the Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ *  Name:      MMA7455_Trigger
+ *  Desc.:     Single-shot capture around a trigger event
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Once armed, samples roll through a caller provided buffer
+ *    of pre + post samples. A hardware trigger (INT1/INT2 pin
+ *    raised by the level or pulse detection) or a software
+ *    threshold on any axis freezes the pre samples that led to
+ *    it, then the post samples are added and the capture stops,
+ *    like the single-shot mode of a scope.
+ *
+ *    DETSRC is only read when the interrupt pin is high, so no
+ *    bus access is spent per sample on the trigger. The latch
+ *    is cleared once read, and by arm(accel) before waiting for
+ *    a new event, so a re-armed trigger does not fire on the
+ *    event of the previous capture.
+ *
+ */
+
+#ifndef __MMA7455_TRIGGER_H__
+#define __MMA7455_TRIGGER_H__
+
+#include "MMA_7455.h"
+
+/* Trigger state */
+typedef enum _TRIGGER_STATE
+{
+  trig_idle = 0,   /* not armed */
+  trig_armed,      /* pre-trigger samples rolling */
+  trig_post,       /* triggered, post-trigger samples */
+  trig_done        /* capture frozen */
+} TRIGGER_STATE;
+
+/* Capture record */
+typedef struct _MMA7455_CAPTURE
+{
+  uint32_t time;   /* trigger sample time, 1 = 1 us */
+  uint8_t  detsrc; /* DETSRC flags, 0 on software trigger */
+  uint16_t pre;    /* samples before the trigger */
+  uint16_t post;   /* samples from the trigger on */
+} MMA7455_CAPTURE;
+
+class MMA7455_Trigger
+{
+  public:
+    MMA7455_Trigger(MMA7455_SAMPLE* buff, uint16_t size);
+    
+    bool    begin(uint16_t pre, uint16_t post);
+    void    setThreshold(uint16_t level); /* |axis| >= level, 0 = off */
+    void    setInterruptPin(uint8_t pin);
+    void    arm(MMA_7455* accel = NULL); /* accel: clears the latch */
+    TRIGGER_STATE getState(void);
+    
+    void    trigger(uint8_t detsrc);
+    bool    add(const MMA7455_SAMPLE* sample);
+    bool    acquire(MMA_7455* accel);
+    
+    void    getCapture(MMA7455_CAPTURE* capture);
+    const MMA7455_SAMPLE* getSample(uint16_t i); /* 0 = oldest */
+  
+  private:
+    MMA7455_SAMPLE* _buff;
+    uint16_t _size;
+    uint16_t _pre;
+    uint16_t _post;
+    uint16_t _threshold;
+    int8_t   _int_pin;
+    volatile bool    _pending;
+    volatile uint8_t _detsrc;
+    TRIGGER_STATE _state;
+    uint16_t _head;      /* next slot written */
+    uint16_t _filled;    /* samples held */
+    uint16_t _start;     /* slot of the oldest captured sample */
+    MMA7455_CAPTURE _capture;
+};
+
+#endif /* __MMA7455_TRIGGER_H__ */
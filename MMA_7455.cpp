@@ -44,36 +44,321 @@
  */
 
 #include "MMA_7455.h"
+#include "MMA7455_Bus.h"
 
-MMA_7455::MMA_7455(MMA7455_PROTOCOL proto)
+#if defined(MMA7455_HOST)
+#include <time.h>
+
+/* minimal Arduino API for host builds (replay only) */
+uint32_t micros(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000UL + ts.tv_nsec / 1000);
+}
+
+static void pinMode(uint8_t pin, uint8_t mode)     { (void)pin; (void)mode; }
+static void digitalWrite(uint8_t pin, uint8_t val) { (void)pin; (void)val; }
+static int  digitalRead(uint8_t pin)               { (void)pin; return LOW; }
+#endif
+
+#if !defined(MMA7455_NO_I2C)
+/* I2C pins for the bus recovery: SDA and SCL are constants
+ * on most cores, PIN_WIRE_SDA/SCL are the macros (AVR, SAM,
+ * SAMD, ESP8266); other cores define MMA7455_SDA_PIN and
+ * MMA7455_SCL_PIN for the whole build */
+#if !defined(MMA7455_SDA_PIN) && defined(PIN_WIRE_SDA) && defined(PIN_WIRE_SCL)
+#define MMA7455_SDA_PIN         (PIN_WIRE_SDA)
+#define MMA7455_SCL_PIN         (PIN_WIRE_SCL)
+#endif
+#endif
+
+#if !defined(MMA7455_NO_SPI)
+/* SPI transaction settings, same as begin() */
+#define MMA7455_SPI_CLOCK       (4000000UL)
+#if defined(ARDUINO)
+#define MMA7455_SPI_MODE        (SPI_MODE0)
+#else
+#define MMA7455_SPI_MODE        (SPI_MODE1)
+#endif
+#endif
+
+/* sign-extend a 10-bit output from its LSB/MSB registers */
+static int16_t mma7455_toInt10(uint8_t lsb, uint8_t msb)
 {
-  if(proto == spi_protocol)
+  uint16_t u_val = lsb | ((msb & XOUTH_MASK) << 8);
+  if(u_val & (1 << 9))
   {
-    this->_protocol = spi_protocol;
-    this->_spi_cs_pin = -1;
+    u_val |= 0xFC00;
   }
-  else
+  return (int16_t)u_val;
+}
+
+/* sign-extend an 11-bit offset from its LSB/MSB registers */
+static int16_t mma7455_toInt11(uint8_t lsb, uint8_t msb)
+{
+  uint16_t u_val = lsb | ((msb & XOFFH_MASK) << 8);
+  if(u_val & (1 << 10))
   {
-    this->_protocol = i2c_protocol;
-    this->_i2c_address = MMA7455_I2C_ADDR1;
+    u_val |= 0xF800;
   }
+  return (int16_t)u_val;
 }
 
-MMA_7455::MMA_7455(MMA7455_PROTOCOL proto, uint8_t pin_addr)
+static uint8_t mma7455_glvl(int sensitivity)
 {
-  if(proto == spi_protocol)
+  switch(sensitivity)
   {
-    this->_protocol = spi_protocol;
-    this->_spi_cs_pin = pin_addr;
+    case 4:
+      return MCTL_GLVL_4G;
+    case 8:
+      return MCTL_GLVL_8G;
+    default:
+      return MCTL_GLVL_2G;
   }
-  else
+}
+
+uint32_t MMA7455_isqrt(uint64_t val)
+{
+  uint64_t res = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+  
+  while(bit > val)  bit >>= 2;
+  while(bit != 0)
+  {
+    if(val >= res + bit)
+    {
+      val -= res + bit;
+      res  = (res >> 1) + bit;
+    }
+    else
+    {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)res;
+}
+
+uint16_t MMA7455_crc16(const uint8_t* data, uint16_t len)
+{
+  uint16_t crc = 0xFFFF;
+  uint8_t  bit = 0;
+  
+  while(len--)
   {
-    this->_protocol = i2c_protocol;
+    crc ^= (uint16_t)(*data++) << 8;
+    for(bit = 0; bit < 8; bit++)
+    {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+void MMA7455_sealCalibration(MMA7455_CALIB* calib)
+{
+  if(calib == NULL)   return;
+  calib->crc = MMA7455_crc16((const uint8_t*)calib,
+                             offsetof(MMA7455_CALIB, crc));
+  return;
+}
+
+bool MMA7455_checkCalibration(const MMA7455_CALIB* calib)
+{
+  if(calib == NULL || calib->version != MMA7455_CALIB_VERSION)  return false;
+  if(calib->range != 2 && calib->range != 4 && calib->range != 8)   return false;
+  return calib->crc == MMA7455_crc16((const uint8_t*)calib,
+                                     offsetof(MMA7455_CALIB, crc));
+}
+
+MMA_7455::MMA_7455(MMA7455_PROTOCOL proto)
+{
+  this->_init(proto);
+}
+
+MMA_7455::MMA_7455(MMA7455_PROTOCOL proto, uint8_t pin_addr)
+{
+  this->_init(proto);
+  if(this->_protocol == spi_protocol)
+    this->_spi_cs_pin = pin_addr;
+  else if(this->_protocol == i2c_protocol)
     this->_i2c_address = pin_addr;
+}
+
+void MMA_7455::_init(MMA7455_PROTOCOL proto)
+{
+  this->_protocol    = proto;
+  this->_i2c_address = MMA7455_I2C_ADDR1;
+  this->_spi_cs_pin  = -1;
+  this->_drdy_pin    = -1;
+  this->_period_us   = 8000;
+  this->_sample_us   = 0;
+  this->_overruns    = 0;
+  this->_status      = 0;
+  this->_retries     = 2;
+  this->_errors      = 0;
+  this->_last_error  = mma_ok;
+  this->_health      = health_ok;
+  this->_bus         = NULL;
+  this->_bus_timeout = 0;
+#if !defined(MMA7455_NO_CAPTURE)
+  this->_capture     = NULL;
+  this->_capture_size = 0;
+  this->_capture_len = 0;
+  this->_capture_ovf = false;
+  this->_replay      = NULL;
+  this->_replay_len  = 0;
+  this->_replay_pos  = 0;
+#endif
+  return;
+}
+
+bool MMA_7455::begin(void)
+{
+  if(!this->_hasTransport())
+  {
+    this->_track(mma_bus_error, 0);
+    return false;
+  }
+  this->_beginBus();
+  
+  this->writeReg(XOFFL_OFF,  0x00);
+  this->writeReg(XOFFH_OFF,  0x00);
+  this->writeReg(YOFFL_OFF,  0x00);
+  this->writeReg(YOFFH_OFF,  0x00);
+  this->writeReg(ZOFFL_OFF,  0x00);
+  this->writeReg(ZOFFH_OFF,  0x00);
+  this->writeReg(MCTL_OFF,   0x00);
+  this->writeReg(INTRST_OFF, 0x03);
+  this->writeReg(INTRST_OFF, 0x00);
+  this->writeReg(CTL1_OFF,   0x00);
+  this->writeReg(CTL2_OFF,   0x00);
+  this->writeReg(LDTH_OFF,   0x00);
+  this->writeReg(PDTH_OFF,   0x00);
+  this->writeReg(PW_OFF,     0x00);
+  this->writeReg(LT_OFF,     0x00);
+  this->writeReg(TW_OFF,     0x00);
+  
+  /* CTL1 reset selects 62.5 Hz bandwidth */
+  this->_period_us = 8000;
+  this->_sample_us = 0;
+  this->_overruns  = 0;
+  this->_status    = 0;
+  
+  /* a dead bus fails every write */
+  return this->_last_error == mma_ok;
+}
+
+bool MMA_7455::begin(const MMA7455_CALIB* calib)
+{
+  uint8_t  regs[TW_OFF - DETSRC_OFF + 1] = {0};
+  uint8_t  image[TW_OFF - XOFFL_OFF + 1] = {0};
+  uint8_t* cur = &regs[XOFFL_OFF - DETSRC_OFF];
+  
+  if(!MMA7455_checkCalibration(calib))
+  {
+    this->begin();
+    return false;
+  }
+  this->_beginBus();
+  
+  /* one burst: interrupt flags, identity and configuration */
+  if(this->readRegs(DETSRC_OFF, regs, sizeof(regs)) != mma_ok)  return false;
+  if(regs[WHOAMI_OFF - DETSRC_OFF] != calib->whoami ||
+     regs[USRINF_OFF - DETSRC_OFF] != calib->usrinf)
+  {
+    /* record of another device */
+    this->begin();
+    return false;
+  }
+  
+  /* same image as begin() with the offsets and range restored */
+  image[XOFFL_OFF - XOFFL_OFF] = calib->offset[0] & XOFFL_MASK;
+  image[XOFFH_OFF - XOFFL_OFF] = (calib->offset[0] >> 8) & XOFFH_MASK;
+  image[YOFFL_OFF - XOFFL_OFF] = calib->offset[1] & YOFFL_MASK;
+  image[YOFFH_OFF - XOFFL_OFF] = (calib->offset[1] >> 8) & YOFFH_MASK;
+  image[ZOFFL_OFF - XOFFL_OFF] = calib->offset[2] & ZOFFL_MASK;
+  image[ZOFFH_OFF - XOFFL_OFF] = (calib->offset[2] >> 8) & ZOFFH_MASK;
+  image[MCTL_OFF  - XOFFL_OFF] = mma7455_glvl(calib->range);
+  
+  if(memcmp(cur, image, sizeof(image)) != 0)
+  {
+    this->writeRegs(XOFFL_OFF, image, sizeof(image));
+  }
+  if(regs[0] & (DETSRC_INT1 | DETSRC_INT2))
+  {
+    this->writeReg(INTRST_OFF, INTRST_CLRINT1 | INTRST_CLRINT2);
+    this->writeReg(INTRST_OFF, 0x00);
+  }
+  
+  /* CTL1 reset selects 62.5 Hz bandwidth */
+  this->_period_us = 8000;
+  this->_sample_us = 0;
+  this->_overruns  = 0;
+  this->_status    = 0;
+  
+  return this->_last_error == mma_ok;
+}
+
+bool MMA_7455::getCalibration(MMA7455_CALIB* calib)
+{
+  uint8_t buff[MCTL_OFF - USRINF_OFF + 1] = {0};
+  uint8_t i = 0;
+  
+  if(calib == NULL)   return false;
+  
+  /* USRINF..MCTL in one burst */
+  if(this->readRegs(USRINF_OFF, buff, sizeof(buff)) != mma_ok)  return false;
+  
+  memset(calib, 0, sizeof(*calib));
+  calib->version = MMA7455_CALIB_VERSION;
+  calib->usrinf  = buff[0];
+  calib->whoami  = buff[WHOAMI_OFF - USRINF_OFF];
+  for(i = 0; i < 3; i++)
+  {
+    calib->offset[i] = mma7455_toInt11(buff[XOFFL_OFF - USRINF_OFF + 2 * i],
+                                       buff[XOFFH_OFF - USRINF_OFF + 2 * i]);
+    calib->scale[i]  = MMA7455_SCALE_ONE;
+  }
+  switch(buff[MCTL_OFF - USRINF_OFF] & MCTL_GLVL_MASK)
+  {
+    case MCTL_GLVL_4G:
+      calib->range = 4;
+      break;
+    case MCTL_GLVL_8G:
+      calib->range = 8;
+      break;
+    default:
+      calib->range = 2;
+      break;
   }
+  MMA7455_sealCalibration(calib);
+  return true;
 }
 
-void MMA_7455::begin(void)
+bool MMA_7455::_hasTransport(void)
+{
+  switch(this->_protocol)
+  {
+#if !defined(MMA7455_NO_I2C)
+    case i2c_protocol:
+      return true;
+#endif
+#if !defined(MMA7455_NO_SPI)
+    case spi_protocol:
+      return true;
+#endif
+#if !defined(MMA7455_NO_CAPTURE)
+    case replay_protocol:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+void MMA_7455::_beginBus(void)
 {
   if(this->_protocol == spi_protocol && _spi_cs_pin >= 0)
   {
@@ -81,6 +366,7 @@ void MMA_7455::begin(void)
     digitalWrite(this->_spi_cs_pin, HIGH);
   }
   
+#if !defined(MMA7455_NO_SPI)
   if(this->_protocol == spi_protocol)
   {
     SPI.begin();
@@ -94,31 +380,20 @@ void MMA_7455::begin(void)
     SPI.setDataMode(SPI_MODE1);
 #endif
   }
-  else if(this->_protocol == i2c_protocol)
+#endif
+#if !defined(MMA7455_NO_I2C)
+  if(this->_protocol == i2c_protocol)
   {
 #if defined(SPARK)
     Wire.setSpeed(CLOCK_SPEED_400KHZ);
 #endif
     Wire.begin();
+#if defined(WIRE_HAS_TIMEOUT)
+    /* never hang on a stuck bus */
+    Wire.setWireTimeout(25000, true);
+#endif
   }
-  
-  this->writeReg(XOFFL_OFF,  0x00);
-  this->writeReg(XOFFH_OFF,  0x00);
-  this->writeReg(YOFFL_OFF,  0x00);
-  this->writeReg(YOFFH_OFF,  0x00);
-  this->writeReg(ZOFFL_OFF,  0x00);
-  this->writeReg(ZOFFH_OFF,  0x00);
-  this->writeReg(MCTL_OFF,   0x00);
-  this->writeReg(INTRST_OFF, 0x03);
-  this->writeReg(INTRST_OFF, 0x00);
-  this->writeReg(CTL1_OFF,   0x00);
-  this->writeReg(CTL2_OFF,   0x00);
-  this->writeReg(LDTH_OFF,   0x00);
-  this->writeReg(PDTH_OFF,   0x00);
-  this->writeReg(PW_OFF,     0x00);
-  this->writeReg(LT_OFF,     0x00);
-  this->writeReg(TW_OFF,     0x00);
-  
+#endif
   return;
 }
 
@@ -133,29 +408,17 @@ void MMA_7455::setChipSelectPin(uint8_t pin)
   return;
 }
 
+void MMA_7455::setBus(MMA7455_Bus* bus, uint16_t timeout_us)
+{
+  /* timeout 0 from an interrupt handler: fail, never wait */
+  this->_bus         = bus;
+  this->_bus_timeout = timeout_us;
+  return;
+}
+
 void MMA_7455::setSensitivity(int sensitivity)
 {
-  uint8_t selected = 0;
-  uint8_t val      = 0;
-  switch(sensitivity)
-  {
-    case 2:
-      selected = MCTL_GLVL_2G;
-      break;
-    case 4:
-      selected = MCTL_GLVL_4G;
-      break;
-    case 8:
-      selected = MCTL_GLVL_8G;
-      break;
-    default:
-      selected = MCTL_GLVL_2G;
-      break;
-  }
-  val = this->readReg(MCTL_OFF);
-  val &= ~MCTL_GLVL_MASK;
-  val |= selected & MCTL_GLVL_MASK;
-  this->writeReg(MCTL_OFF, val);
+  this->_updateReg(MCTL_OFF, MCTL_GLVL_MASK, mma7455_glvl(sensitivity));
   return;
 }
 
@@ -187,7 +450,6 @@ int MMA_7455::getSensitivity(void)
 void MMA_7455::setMode(MODE mode)
 {
   uint8_t selected = 0;
-  uint8_t val      = 0;
   switch(mode)
   {
     case standby:
@@ -206,10 +468,7 @@ void MMA_7455::setMode(MODE mode)
       selected = MCTL_MOD_MSMT;
       break;
   }
-  val = this->readReg(MCTL_OFF);
-  val &= ~MCTL_MOD_MASK;
-  val |= selected & MCTL_MOD_MASK;
-  this->writeReg(MCTL_OFF, val);
+  this->_updateReg(MCTL_OFF, MCTL_MOD_MASK, selected);
   return;
 }
 
@@ -243,116 +502,202 @@ MODE MMA_7455::getMode(void)
 
 void MMA_7455::setSelfTest(bool enable)
 {
-  uint8_t val = this->readReg(MCTL_OFF);
-  if(enable)
+  this->_updateReg(MCTL_OFF, MCTL_STON, enable ? MCTL_STON : 0);
+  return;
+}
+
+bool MMA_7455::runSelfTest(MMA7455_SELFTEST* result, uint8_t samples)
+{
+  uint8_t  mctl  = 0;
+  int16_t  x0 = 0, y0 = 0, z0 = 0;
+  int16_t  x1 = 0, y1 = 0, z1 = 0;
+  int16_t  dummy = 0;
+  uint8_t  drop  = 0;
+  uint32_t wait  = 0;
+  bool     valid = false;
+  
+  if(result == NULL)    return false;
+  if(samples == 0)      samples = 1;
+  memset(result, 0, sizeof(MMA7455_SELFTEST));
+  
+  mctl = this->readReg(MCTL_OFF);
+  if(this->_last_error != mma_ok)   return false;
+  
+  /* after each MCTL write, drop the conversions of the
+   * turn-on (t_ru) or of the cell deflecting (t_st), and
+   * wait for the first one up to that time and a period */
+  drop = (MMA7455_ST_SETTLE_US + this->_period_us - 1) / this->_period_us;
+  wait = MMA7455_ST_SETTLE_US + this->_period_us;
+  
+  /* conversions only run in measurement mode */
+  this->writeReg(MCTL_OFF, (mctl & ~(MCTL_MOD_MASK | MCTL_STON)) | MCTL_MOD_MSMT);
+  valid = this->_averageSample(drop, &dummy, &dummy, &dummy, wait) &&
+          this->_averageSample(samples, &x0, &y0, &z0, 0);
+  if(valid)
   {
-    val |= MCTL_STON;
+    this->writeReg(MCTL_OFF, (mctl & ~MCTL_MOD_MASK) | MCTL_MOD_MSMT | MCTL_STON);
+    valid = this->_averageSample(drop, &dummy, &dummy, &dummy, wait) &&
+            this->_averageSample(samples, &x1, &y1, &z1, 0);
   }
-  else
+  this->writeReg(MCTL_OFF, mctl);
+  if(!valid || this->_last_error != mma_ok)  return false;
+  
+  /* the 10-bit outputs are 8g whatever GLVL, and only
+   * the Z axis is trimmed (1g, 64 counts typical) */
+  result->x    = x1 - x0;
+  result->y    = y1 - y0;
+  result->z    = z1 - z0;
+  result->pass = result->z >= MMA7455_ST_Z_MIN && result->z <= MMA7455_ST_Z_MAX;
+  return true;
+}
+
+bool MMA_7455::_averageSample(uint8_t samples, int16_t* x, int16_t* y, int16_t* z,
+                              uint32_t first_us)
+{
+  int32_t  sum[3] = {0};
+  int16_t  val[3] = {0};
+  uint8_t  i      = 0;
+  uint32_t start  = 0;
+  uint32_t limit  = 0;
+  
+  for(i = 0; i < samples; i++)
+  {
+    /* a missing conversion must not hang the caller,
+     * the first one may take first_us (turn-on) */
+    limit = 4UL * this->_period_us;
+    if(i == 0 && first_us > limit)  limit = first_us;
+    start = micros();
+    while(!this->readSample10(&val[0], &val[1], &val[2]))
+    {
+      if(this->_last_error != mma_ok)   return false;
+      if(micros() - start > limit)  return false;
+    }
+    sum[0] += val[0];
+    sum[1] += val[1];
+    sum[2] += val[2];
+  }
+  *x = sum[0] / samples;
+  *y = sum[1] / samples;
+  *z = sum[2] / samples;
+  return true;
+}
+
+void MMA_7455::setDataRate(DATA_RATE rate)
+{
+  if(this->_updateReg(CTL1_OFF, CTL1_DFBW, rate) == mma_ok)
   {
-    val &= ~MCTL_STON;
+    this->_period_us = (rate == odr_250hz) ? 4000 : 8000;
   }
-  this->writeReg(MCTL_OFF, val);
   return;
 }
 
-void MMA_7455::enableDetectionXYZ(bool x, bool y, bool z)
+DATA_RATE MMA_7455::getDataRate(void)
 {
   uint8_t val = this->readReg(CTL1_OFF);
+  this->_period_us = (val & CTL1_DFBW) ? 4000 : 8000;
+  return (val & CTL1_DFBW) ? odr_250hz : odr_125hz;
+}
+
+uint16_t MMA_7455::getSamplePeriod(void)
+{
+  return this->_period_us;
+}
+
+void MMA_7455::setDataReadyPin(uint8_t pin)
+{
+  this->_drdy_pin = pin;
+  pinMode(this->_drdy_pin, INPUT);
+  return;
+}
+
+bool MMA_7455::dataReady(void)
+{
+  uint32_t elapsed = 0;
   
-  /* enable/disable detection on X */
-  if(x) val &= ~CTL1_XDA_DIS;
-  else  val |= CTL1_XDA_DIS;
-  /* enable/disable detection on Y */
-  if(y) val &= ~CTL1_YDA_DIS;
-  else  val |= CTL1_YDA_DIS;
-  /* enable/disable detection on Z */
-  if(z) val &= ~CTL1_ZDA_DIS;
-  else  val |= CTL1_ZDA_DIS;
+#if !defined(MMA7455_NO_CAPTURE)
+  /* replay at full speed: poll STATUS only
+   * if the capture did, otherwise data is ready */
+  if(this->_protocol == replay_protocol)
+  {
+    if(!this->_replayNext(false, STATUS_OFF, 1))  return true;
+    this->_status = this->readReg(STATUS_OFF);
+    return (this->_status & STATUS_DRDY) ? true : false;
+  }
+#endif
   
-  this->writeReg(CTL1_OFF, val);
+  /* DRDY pin is kept high until the outputs are read;
+   * STATUS is not read on this path, so DOVR (overruns)
+   * is not seen and getOverrunCount() stays at 0 */
+  if(this->_drdy_pin >= 0)
+  {
+    return digitalRead(this->_drdy_pin) == HIGH;
+  }
+  
+  /* no bus access before the next conversion is due,
+   * with 1/8 of a period of margin for clock drift */
+  elapsed = micros() - this->_sample_us;
+  if(elapsed < (uint32_t)(this->_period_us - (this->_period_us >> 3)))
+  {
+    return false;
+  }
+  
+  this->_status = this->readReg(STATUS_OFF);
+  return (this->_status & STATUS_DRDY) ? true : false;
+}
+
+uint32_t MMA_7455::getSampleTime(void)
+{
+  return this->_sample_us;
+}
+
+uint16_t MMA_7455::getOverrunCount(void)
+{
+  return this->_overruns;
+}
+
+void MMA_7455::enableDetectionXYZ(bool x, bool y, bool z)
+{
+  uint8_t val = 0;
+  
+  /* a set bit disables the detection on its axis */
+  if(!x)  val |= CTL1_XDA_DIS;
+  if(!y)  val |= CTL1_YDA_DIS;
+  if(!z)  val |= CTL1_ZDA_DIS;
+  
+  this->_updateReg(CTL1_OFF, CTL1_XDA_DIS | CTL1_YDA_DIS | CTL1_ZDA_DIS, val);
   return;
 }
 
 void MMA_7455::setLevelPolarity(LEVEL_MODE mode)
 {
-  uint8_t val = this->readReg(CTL2_OFF);
-  switch(mode)
-  {
-    case lvl_positive:
-      val &= ~CTL2_LDPL;
-      break;
-    case lvl_freefall:
-      val |= CTL2_LDPL;
-      break;
-    default:
-      val &= ~CTL2_LDPL;
-      break;
-  }
-  this->writeReg(CTL2_OFF, val);
+  this->_updateReg(CTL2_OFF, CTL2_LDPL,
+                   (mode == lvl_freefall) ? CTL2_LDPL : 0);
   return;
 }
 
 void MMA_7455::setLevelPolarity(unsigned int mode)
 {
-  uint8_t val = this->readReg(CTL2_OFF);
-  switch(mode)
-  {
-    case 0:
-      val &= ~CTL2_LDPL;
-      break;
-    case 1:
-      val |= CTL2_LDPL;
-      break;
-    default:
-      val &= ~CTL2_LDPL;
-      break;
-  }
-  this->writeReg(CTL2_OFF, val);
+  this->setLevelPolarity((mode == 1) ? lvl_freefall : lvl_positive);
   return;
 }
 
 void MMA_7455::setThresholdMode(TH_MODE mode)
 {
-  uint8_t val = this->readReg(CTL1_OFF);
-  switch(mode)
-  {
-    case th_absolute:
-      val &= ~CTL1_THOPT;
-      break;
-    case th_signed:
-      val |= CTL1_THOPT;
-      break;
-    default:
-      val &= ~CTL1_THOPT;
-      break;
-  }
-  this->writeReg(CTL1_OFF, val);
+  this->_updateReg(CTL1_OFF, CTL1_THOPT,
+                   (mode == th_signed) ? CTL1_THOPT : 0);
   return;
 }
 
 void MMA_7455::setThresholdMode(unsigned int mode)
 {
-  uint8_t val = this->readReg(CTL1_OFF);
-  switch(mode)
-  {
-    case 0:
-      val &= ~CTL1_THOPT;
-      break;
-    case 1:
-      val |= CTL1_THOPT;
-      break;
-    default:
-      val &= ~CTL1_THOPT;
-      break;
-  }
-  this->writeReg(CTL1_OFF, val);
+  this->setThresholdMode((mode == 1) ? th_signed : th_absolute);
   return;
 }
 
 void MMA_7455::setLevelThresholdLimit(int8_t limit)
 {
   uint8_t val = this->readReg(CTL1_OFF);
+  if(this->_last_error != mma_ok)   return;
   if(val & CTL1_THOPT)
   {
     /* signed value of 8-bit */
@@ -387,39 +732,14 @@ void MMA_7455::setLevelThresholdLimit(int8_t limit)
 
 void MMA_7455::setPulsePolarity(PULSE_MODE mode)
 {
-  uint8_t val = this->readReg(CTL2_OFF);
-  switch(mode)
-  {
-    case pls_positive:
-      val &= ~CTL2_PDPL;
-      break;
-    case pls_negative:
-      val |= CTL2_PDPL;
-      break;
-    default:
-      val &= ~CTL2_PDPL;
-      break;
-  }
-  this->writeReg(CTL2_OFF, val);
+  this->_updateReg(CTL2_OFF, CTL2_PDPL,
+                   (mode == pls_negative) ? CTL2_PDPL : 0);
   return;
 }
 
 void MMA_7455::setPulsePolarity(unsigned int mode)
 {
-  uint8_t val = this->readReg(CTL2_OFF);
-  switch(mode)
-  {
-    case 0:
-      val &= ~CTL2_PDPL;
-      break;
-    case 1:
-      val |= CTL2_PDPL;
-      break;
-    default:
-      val &= ~CTL2_PDPL;
-      break;
-  }
-  this->writeReg(CTL2_OFF, val);
+  this->setPulsePolarity((mode == 1) ? pls_negative : pls_positive);
   return;
 }
 
@@ -488,12 +808,16 @@ int8_t MMA_7455::readAxis8(char axis)
 
 void MMA_7455::readAxis8(int8_t* x, int8_t* y, int8_t* z)
 {
-  if(x) *x = this->readAxis8('x');
-  if(y) *y = this->readAxis8('y');
-  if(z) *z = this->readAxis8('z');
+  uint8_t buff[3] = {0};
+  
+  this->readRegs(XOUT8_OFF, buff, 3);
+  if(x) *x = (int8_t)(buff[0] & XOUT8_MASK);
+  if(y) *y = (int8_t)(buff[1] & YOUT8_MASK);
+  if(z) *z = (int8_t)(buff[2] & ZOUT8_MASK);
   return;
 }
 
+#if !defined(MMA7455_NO_FLOAT)
 float MMA_7455::readAxis8g(char axis)
 {
   float  f_val = 0;
@@ -518,6 +842,7 @@ void MMA_7455::readAxis8g(float* x, float* y, float* z)
   if(z) *z = this->readAxis8g('z');
   return;
 }
+#endif
 
 int16_t MMA_7455::readAxis10(char axis)
 {
@@ -563,12 +888,17 @@ int16_t MMA_7455::readAxis10(char axis)
 
 void MMA_7455::readAxis10(int16_t* x, int16_t* y, int16_t* z)
 {
-  if(x) *x = this->readAxis10('x');
-  if(y) *y = this->readAxis10('y');
-  if(z) *z = this->readAxis10('z');
+  uint8_t buff[6] = {0};
+  
+  /* one burst: XOUTL..ZOUTH */
+  this->readRegs(XOUTL_OFF, buff, 6);
+  if(x) *x = mma7455_toInt10(buff[0], buff[1]);
+  if(y) *y = mma7455_toInt10(buff[2], buff[3]);
+  if(z) *z = mma7455_toInt10(buff[4], buff[5]);
   return;
 }
 
+#if !defined(MMA7455_NO_FLOAT)
 float MMA_7455::readAxis10g(char axis)
 {
   float   f_val = 0;
@@ -593,6 +923,89 @@ void MMA_7455::readAxis10g(float* x, float* y, float* z)
   if(z) *z = this->readAxis10g('z');
   return;
 }
+#endif
+
+bool MMA_7455::readSample8(int8_t* x, int8_t* y, int8_t* z)
+{
+  if(!this->dataReady())    return false;
+  
+  this->readAxis8(x, y, z);
+  if(this->_last_error != mma_ok)   return false;
+  this->_sample_us = micros();
+  if(this->_status & STATUS_DOVR) this->_overruns++;
+  this->_status = 0;
+  return true;
+}
+
+bool MMA_7455::readSample10(int16_t* x, int16_t* y, int16_t* z)
+{
+  if(!this->dataReady())    return false;
+  
+  this->readAxis10(x, y, z);
+  if(this->_last_error != mma_ok)   return false;
+  this->_sample_us = micros();
+  if(this->_status & STATUS_DOVR) this->_overruns++;
+  this->_status = 0;
+  return true;
+}
+
+bool MMA_7455::readSample(MMA7455_SAMPLE* sample)
+{
+  if(sample == NULL)    return false;
+  if(!this->readSample10(&sample->x, &sample->y, &sample->z))   return false;
+  sample->time = this->_sample_us;
+  return true;
+}
+
+uint16_t MMA_7455::readBlock(SAMPLE_FORMAT fmt, void* x, void* y, void* z,
+                             uint16_t n, uint16_t stride)
+{
+  uint8_t  buff[6] = {0};
+  uint8_t  reg     = (fmt == fmt_8bit) ? XOUT8_OFF : XOUTL_OFF;
+  uint8_t  len     = (fmt == fmt_8bit) ? 3 : 6;
+  uint32_t start   = 0;
+  uint32_t pos     = 0;
+  uint16_t i       = 0;
+  
+  /* element i of an axis is at [i * stride], NULL axes are skipped:
+   * interleaved XYZ is x = buff, y = buff + 1, z = buff + 2, stride 3 */
+  if(stride == 0)   stride = 1;
+  
+  for(i = 0; i < n; i++, pos += stride)
+  {
+    start = micros();
+    while(!this->dataReady())
+    {
+      if(this->_last_error != mma_ok)   return i;
+      if(micros() - start > 4UL * this->_period_us)   return i;
+    }
+    if(this->readRegs(reg, buff, len) != mma_ok)  return i;
+    this->_sample_us = micros();
+    if(this->_status & STATUS_DOVR) this->_overruns++;
+    this->_status = 0;
+    
+    /* decoded straight into the caller arrays */
+    switch(fmt)
+    {
+      case fmt_8bit:
+        if(x) ((int8_t*)x)[pos] = (int8_t)(buff[0] & XOUT8_MASK);
+        if(y) ((int8_t*)y)[pos] = (int8_t)(buff[1] & YOUT8_MASK);
+        if(z) ((int8_t*)z)[pos] = (int8_t)(buff[2] & ZOUT8_MASK);
+        break;
+      case fmt_10bit:
+        if(x) ((int16_t*)x)[pos] = mma7455_toInt10(buff[0], buff[1]);
+        if(y) ((int16_t*)y)[pos] = mma7455_toInt10(buff[2], buff[3]);
+        if(z) ((int16_t*)z)[pos] = mma7455_toInt10(buff[4], buff[5]);
+        break;
+      default:
+        if(x) ((uint16_t*)x)[pos] = buff[0] | (buff[1] << 8);
+        if(y) ((uint16_t*)y)[pos] = buff[2] | (buff[3] << 8);
+        if(z) ((uint16_t*)z)[pos] = buff[4] | (buff[5] << 8);
+        break;
+    }
+  }
+  return n;
+}
 
 void MMA_7455::setAxisOffset(int16_t x, int16_t y, int16_t z)
 {
@@ -629,10 +1042,7 @@ void MMA_7455::getAxisOffset(int16_t* x, int16_t* y, int16_t* z)
 
 void MMA_7455::setInterruptMode(ISR_MODE mode)
 {
-  uint8_t val = this->readReg(CTL1_OFF);
-  val &= ~CTL1_INTRG_MASK;
-  val |= mode & CTL1_INTRG_MASK;
-  this->writeReg(CTL1_OFF, val);
+  this->_updateReg(CTL1_OFF, CTL1_INTRG_MASK, mode);
   return;
 }
 
@@ -662,6 +1072,11 @@ void MMA_7455::getInterrupt(bool* int1, bool* int2)
   return;
 }
 
+uint8_t MMA_7455::getDetectionSource(void)
+{
+  return this->readReg(DETSRC_OFF);
+}
+
 void MMA_7455::clearInterrupt(void)
 {
   this->writeReg(INTRST_OFF, INTRST_CLRINT1 | INTRST_CLRINT2);
@@ -671,35 +1086,306 @@ void MMA_7455::clearInterrupt(void)
 
 void MMA_7455::enableInterruptPins(bool enable)
 {
-  uint8_t val = this->readReg(MCTL_OFF);
-  if(enable)    val |= MCTL_DRPD;
-  else          val &= ~MCTL_DRPD;
-  this->writeReg(MCTL_OFF, val);
+  this->_updateReg(MCTL_OFF, MCTL_DRPD, enable ? MCTL_DRPD : 0);
   return;
 }
 
-uint8_t MMA_7455::readReg(uint8_t reg)
+bool MMA_7455::isPresent(void)
 {
+  uint8_t val = this->readReg(I2CAD_OFF);
+  
+  if(this->_last_error != mma_ok)   return false;
+  
+  /* WHOAMI is optional (OTP) on the MMA7455L,
+   * the device address register is always set */
+  val &= I2CAD_DAD_MASK;
+  if(_protocol == i2c_protocol)
+    return val == this->_i2c_address;
+  else
+    return val == MMA7455_I2C_ADDR1 || val == MMA7455_I2C_ADDR2;
+}
+
+bool MMA_7455::recoverBus(void)
+{
+  if(_protocol == replay_protocol)  return true;
   if(_protocol == spi_protocol)
-    return this->_readRegSPI(reg);
+  {
+    /* nothing latched on SPI beyond the chip select */
+    if(this->_spi_cs_pin >= 0)  digitalWrite(this->_spi_cs_pin, HIGH);
+    return true;
+  }
+  
+#if !defined(MMA7455_NO_I2C)
+#if defined(MMA7455_SDA_PIN) && defined(MMA7455_SCL_PIN)
+  uint8_t i    = 0;
+  bool    idle = false;
+  
+#if defined(WIRE_HAS_END)
+  Wire.end();
+#endif
+  pinMode(MMA7455_SDA_PIN, INPUT_PULLUP);
+  pinMode(MMA7455_SCL_PIN, INPUT_PULLUP);
+  
+  /* clock out up to 9 bits until the slave releases SDA */
+  for(i = 0; i < 9 && digitalRead(MMA7455_SDA_PIN) == LOW; i++)
+  {
+    pinMode(MMA7455_SCL_PIN, OUTPUT);
+    digitalWrite(MMA7455_SCL_PIN, LOW);
+    delayMicroseconds(5);
+    pinMode(MMA7455_SCL_PIN, INPUT_PULLUP);
+    delayMicroseconds(5);
+  }
+  
+  /* STOP condition: SDA rising while SCL is high */
+  pinMode(MMA7455_SCL_PIN, OUTPUT);
+  digitalWrite(MMA7455_SCL_PIN, LOW);
+  pinMode(MMA7455_SDA_PIN, OUTPUT);
+  digitalWrite(MMA7455_SDA_PIN, LOW);
+  delayMicroseconds(5);
+  pinMode(MMA7455_SCL_PIN, INPUT_PULLUP);
+  delayMicroseconds(5);
+  pinMode(MMA7455_SDA_PIN, INPUT_PULLUP);
+  delayMicroseconds(5);
+  
+  idle = (digitalRead(MMA7455_SDA_PIN) == HIGH && digitalRead(MMA7455_SCL_PIN) == HIGH);
+#endif
+  
+  Wire.begin();
+#if defined(WIRE_HAS_TIMEOUT)
+  Wire.setWireTimeout(25000, true);
+#endif
+#if defined(MMA7455_SDA_PIN) && defined(MMA7455_SCL_PIN)
+  return idle;
+#else
+  /* pins unknown: Wire restarted, the bus is not recovered */
+  return false;
+#endif
+#endif
+  return true;
+}
+
+void MMA_7455::setRetries(uint8_t retries)
+{
+  /* keeps the uint8_t attempt counters from wrapping */
+  if(retries > MMA7455_MAX_RETRIES)   retries = MMA7455_MAX_RETRIES;
+  this->_retries = retries;
+  return;
+}
+
+MMA7455_STATUS MMA_7455::getLastError(void)
+{
+  return this->_last_error;
+}
+
+MMA7455_HEALTH MMA_7455::getHealth(void)
+{
+  return this->_health;
+}
+
+uint16_t MMA_7455::getErrorCount(void)
+{
+  return this->_errors;
+}
+
+void MMA_7455::resetHealth(void)
+{
+  this->_health = health_ok;
+  this->_errors = 0;
+  return;
+}
+
+#if !defined(MMA7455_NO_CAPTURE)
+void MMA_7455::setCapture(uint8_t* buff, uint16_t size)
+{
+  this->_capture      = buff;
+  this->_capture_size = (buff != NULL) ? size : 0;
+  this->_capture_len  = 0;
+  this->_capture_ovf  = false;
+  return;
+}
+
+uint16_t MMA_7455::getCaptureLength(void)
+{
+  return this->_capture_len;
+}
+
+bool MMA_7455::captureOverflow(void)
+{
+  return this->_capture_ovf;
+}
+
+void MMA_7455::setReplay(const uint8_t* buff, uint16_t len)
+{
+  this->_replay     = buff;
+  this->_replay_len = (buff != NULL) ? len : 0;
+  this->_replay_pos = 0;
+  return;
+}
+
+bool MMA_7455::replayDone(void)
+{
+  return this->_replay_pos >= this->_replay_len;
+}
+
+void MMA_7455::_record(bool write, uint8_t reg, const uint8_t* buff,
+                       uint8_t len, MMA7455_STATUS status)
+{
+  uint8_t head = 0;
+  
+  if(this->_capture == NULL || this->_capture_ovf)  return;
+  
+  /* stop on the first record that does not fit, a
+   * truncated capture would desync the whole replay */
+  if(len == 0 || len > MMA7455_REC_LEN_MASK + 1 ||
+     this->_capture_len + 2 + len > this->_capture_size)
+  {
+    this->_capture_ovf = true;
+    return;
+  }
+  
+  if(status > mma_bus_error)  status = mma_bus_error;
+  head  = write ? MMA7455_REC_WRITE : 0;
+  head |= (status << 5) & MMA7455_REC_STATUS_MASK;
+  head |= (len - 1) & MMA7455_REC_LEN_MASK;
+  
+  this->_capture[this->_capture_len++] = head;
+  this->_capture[this->_capture_len++] = reg;
+  memcpy(&this->_capture[this->_capture_len], buff, len);
+  this->_capture_len += len;
+  return;
+}
+
+bool MMA_7455::_replayNext(bool write, uint8_t reg, uint8_t len)
+{
+  uint8_t head = 0;
+  
+  if(this->_replay == NULL ||
+     this->_replay_pos + 2 > this->_replay_len)   return false;
+  
+  head = this->_replay[this->_replay_pos];
+  return ((head & MMA7455_REC_WRITE) ? true : false) == write &&
+         this->_replay[this->_replay_pos + 1] == reg &&
+         (head & MMA7455_REC_LEN_MASK) + 1 == len;
+}
+
+MMA7455_STATUS MMA_7455::_replayRegs(bool write, uint8_t reg,
+                                     uint8_t* buff, uint8_t len)
+{
+  const uint8_t* data = NULL;
+  uint8_t        head = 0;
+  
+  if(this->replayDone())    return mma_replay_end;
+  if(!this->_replayNext(write, reg, len) ||
+     this->_replay_pos + 2 + len > this->_replay_len)
+  {
+    return mma_replay_mismatch;
+  }
+  
+  head = this->_replay[this->_replay_pos];
+  data = &this->_replay[this->_replay_pos + 2];
+  if(write)
+  {
+    /* the driver must write what the capture wrote */
+    if(memcmp(data, buff, len) != 0)  return mma_replay_mismatch;
+  }
   else
-    return this->_readRegI2C(reg);
+  {
+    memcpy(buff, data, len);
+  }
+  this->_replay_pos += 2 + len;
+  return (MMA7455_STATUS)((head & MMA7455_REC_STATUS_MASK) >> 5);
 }
+#endif
 
-uint8_t MMA_7455::_readRegI2C(uint8_t reg)
+uint8_t MMA_7455::readReg(uint8_t reg)
 {
   uint8_t buff = 0;
+  this->readRegs(reg, &buff, 1);
+  return buff;
+}
+
+MMA7455_STATUS MMA_7455::readRegs(uint8_t reg, uint8_t* buff, uint8_t len)
+{
+  MMA7455_STATUS status  = mma_ok;
+  uint8_t        attempt = 0;
+  
+  if(buff == NULL || len == 0)  return mma_ok;
+  if(!this->_hasTransport())
+  {
+    memset(buff, 0, len);
+    this->_track(mma_bus_error, 0);
+    return mma_bus_error;
+  }
+  if(!this->_busLock())
+  {
+    memset(buff, 0, len);
+    this->_last_error = mma_busy;
+    return mma_busy;
+  }
+  
+  do
+  {
+    if(attempt > 0)   this->_recover(status);
+#if !defined(MMA7455_NO_SPI)
+    if(_protocol == spi_protocol) status = this->_readRegsSPI(reg, buff, len);
+#endif
+#if !defined(MMA7455_NO_I2C)
+    if(_protocol == i2c_protocol) status = this->_readRegsI2C(reg, buff, len);
+#endif
+#if !defined(MMA7455_NO_CAPTURE)
+    /* the capture holds the outcome after retries */
+    if(_protocol == replay_protocol)
+    {
+      status = this->_replayRegs(false, reg, buff, len);
+      break;
+    }
+#endif
+  } while(status != mma_ok && attempt++ < this->_retries);
+  this->_busUnlock();
+  
+  /* a failed read must never look like a valid 0g sample */
+  if(status != mma_ok)  memset(buff, 0, len);
+  this->_track(status, attempt);
+#if !defined(MMA7455_NO_CAPTURE)
+  this->_record(false, reg, buff, len, status);
+#endif
+  return status;
+}
+
+#if !defined(MMA7455_NO_I2C)
+MMA7455_STATUS MMA_7455::_readRegsI2C(uint8_t reg, uint8_t* buff, uint8_t len)
+{
+  uint8_t i   = 0;
+  uint8_t err = 0;
+  
   Wire.beginTransmission(this->_i2c_address);
   Wire.write(reg);
-  Wire.endTransmission();
-  Wire.beginTransmission(this->_i2c_address);
-  Wire.requestFrom(this->_i2c_address, (uint8_t)1);
-  if(Wire.available())
+  err = Wire.endTransmission();
+  if(err != 0)  return this->_i2cStatus(err);
+  
+  /* register address auto-increments after each byte */
+  if(Wire.requestFrom(this->_i2c_address, len) != len)
   {
-    buff = Wire.read();
+    while(Wire.available())   Wire.read();
+    return mma_timeout;
   }
-  Wire.endTransmission();
-  return buff;
+  for(i = 0; i < len; i++)
+  {
+    buff[i] = Wire.read();
+  }
+  return mma_ok;
+}
+#endif
+
+#if !defined(MMA7455_NO_SPI)
+MMA7455_STATUS MMA_7455::_readRegsSPI(uint8_t reg, uint8_t* buff, uint8_t len)
+{
+  uint8_t i = 0;
+  for(i = 0; i < len; i++)
+  {
+    buff[i] = this->_readRegSPI(reg + i);
+  }
+  return mma_ok;
 }
 
 uint8_t MMA_7455::_readRegSPI(uint8_t reg)
@@ -713,24 +1399,82 @@ uint8_t MMA_7455::_readRegSPI(uint8_t reg)
   digitalWrite(this->_spi_cs_pin, HIGH);
   return buff;
 }
+#endif
 
-void MMA_7455::writeReg(uint8_t reg, uint8_t val)
+MMA7455_STATUS MMA_7455::writeReg(uint8_t reg, uint8_t val)
 {
-  if(_protocol == spi_protocol) this->_writeRegSPI(reg, val);
-  else                          this->_writeRegI2C(reg, val);
-  return;
+  return this->writeRegs(reg, &val, 1);
+}
+
+MMA7455_STATUS MMA_7455::writeRegs(uint8_t reg, const uint8_t* buff, uint8_t len)
+{
+  MMA7455_STATUS status  = mma_ok;
+  uint8_t        attempt = 0;
+  
+  if(buff == NULL || len == 0)  return mma_ok;
+  if(!this->_hasTransport())
+  {
+    this->_track(mma_bus_error, 0);
+    return mma_bus_error;
+  }
+  if(!this->_busLock())
+  {
+    this->_last_error = mma_busy;
+    return mma_busy;
+  }
+  
+  do
+  {
+    if(attempt > 0)   this->_recover(status);
+#if !defined(MMA7455_NO_SPI)
+    if(_protocol == spi_protocol) status = this->_writeRegsSPI(reg, buff, len);
+#endif
+#if !defined(MMA7455_NO_I2C)
+    if(_protocol == i2c_protocol) status = this->_writeRegsI2C(reg, buff, len);
+#endif
+#if !defined(MMA7455_NO_CAPTURE)
+    if(_protocol == replay_protocol)
+    {
+      status = this->_replayRegs(true, reg, (uint8_t*)buff, len);
+      break;
+    }
+#endif
+  } while(status != mma_ok && attempt++ < this->_retries);
+  this->_busUnlock();
+  
+  this->_track(status, attempt);
+#if !defined(MMA7455_NO_CAPTURE)
+  this->_record(true, reg, buff, len, status);
+#endif
+  return status;
 }
 
-void MMA_7455::_writeRegI2C(uint8_t reg, uint8_t val)
+MMA7455_STATUS MMA_7455::_updateReg(uint8_t reg, uint8_t mask, uint8_t bits)
 {
+  uint8_t val = this->readReg(reg);
+  uint8_t upd = 0;
+  
+  /* never write back a value that failed to read */
+  if(this->_last_error != mma_ok)   return this->_last_error;
+  
+  upd = (val & ~mask) | (bits & mask);
+  if(upd == val)    return mma_ok;
+  return this->writeReg(reg, upd);
+}
+
+#if !defined(MMA7455_NO_I2C)
+MMA7455_STATUS MMA_7455::_writeRegsI2C(uint8_t reg, const uint8_t* buff, uint8_t len)
+{
+  /* the register address auto-increments */
   Wire.beginTransmission(this->_i2c_address);
   Wire.write(reg);
-  Wire.write(val);
-  Wire.endTransmission();
-  return;
+  Wire.write(buff, len);
+  return this->_i2cStatus(Wire.endTransmission());
 }
+#endif
 
-void MMA_7455::_writeRegSPI(uint8_t reg, uint8_t val)
+#if !defined(MMA7455_NO_SPI)
+MMA7455_STATUS MMA_7455::_writeRegSPI(uint8_t reg, uint8_t val)
 {
   digitalWrite(this->_spi_cs_pin, LOW);
   reg |= MMA7455_OPCODE_MASK;
@@ -738,5 +1482,90 @@ void MMA_7455::_writeRegSPI(uint8_t reg, uint8_t val)
   SPI.transfer(reg);
   SPI.transfer(val);
   digitalWrite(this->_spi_cs_pin, HIGH);
+  return mma_ok;
+}
+
+MMA7455_STATUS MMA_7455::_writeRegsSPI(uint8_t reg, const uint8_t* buff, uint8_t len)
+{
+  uint8_t i = 0;
+  
+  /* no auto-increment on SPI, one frame per register */
+  for(i = 0; i < len; i++)
+  {
+    this->_writeRegSPI(reg + i, buff[i]);
+  }
+  return mma_ok;
+}
+#endif
+
+#if !defined(MMA7455_NO_I2C)
+MMA7455_STATUS MMA_7455::_i2cStatus(uint8_t err)
+{
+  switch(err)
+  {
+    case 0:
+      return mma_ok;
+    case 2:   /* address NACK */
+    case 3:   /* data NACK */
+      return mma_nack;
+    case 5:   /* Wire timeout */
+      return mma_timeout;
+    default:
+      return mma_bus_error;
+  }
+}
+#endif
+
+bool MMA_7455::_busLock(void)
+{
+  if(this->_bus != NULL && !this->_bus->lock(this->_bus_timeout))
+  {
+    return false;
+  }
+#if !defined(MMA7455_NO_SPI) && defined(SPI_HAS_TRANSACTION)
+  /* one transaction per burst, other SPI users keep their settings */
+  if(this->_protocol == spi_protocol)
+  {
+    SPI.beginTransaction(SPISettings(MMA7455_SPI_CLOCK, MSBFIRST, MMA7455_SPI_MODE));
+  }
+#endif
+  return true;
+}
+
+void MMA_7455::_busUnlock(void)
+{
+#if !defined(MMA7455_NO_SPI) && defined(SPI_HAS_TRANSACTION)
+  if(this->_protocol == spi_protocol)   SPI.endTransaction();
+#endif
+  if(this->_bus != NULL)  this->_bus->unlock();
+  return;
+}
+
+void MMA_7455::_recover(MMA7455_STATUS status)
+{
+  /* a NACK means the bus is alive, only a stuck
+   * or timed out bus is worth clocking out */
+  if(status == mma_timeout || status == mma_bus_error)
+  {
+    this->recoverBus();
+  }
+  return;
+}
+
+void MMA_7455::_track(MMA7455_STATUS status, uint8_t attempt)
+{
+  /* attempt is the number of failed transfers */
+  this->_last_error = status;
+  this->_errors = (this->_errors > 0xFFFF - attempt) ?
+                  0xFFFF : this->_errors + attempt;
+  if(status != mma_ok)
+  {
+    this->_health = health_failed;
+  }
+  else if(attempt > 0 || this->_health == health_failed)
+  {
+    /* recovered, but keep the trace until resetHealth() */
+    this->_health = health_degraded;
+  }
   return;
 }
@@ -47,14 +47,55 @@
 #ifndef __MMA_7455_H__
 #define __MMA_7455_H__
 
+/* Footprint options, to be defined for the whole build
+ * (e.g. build_flags = -DMMA7455_NO_SPI with PlatformIO):
+ *   MMA7455_NO_I2C    SPI only, drops the Wire dependency
+ *   MMA7455_NO_SPI    I2C only, drops the SPI dependency
+ *   MMA7455_NO_FLOAT  integer only, drops the readAxis*g() API
+ *   MMA7455_NO_CAPTURE  drops the bus capture and replay
+ *   MMA7455_SDA_PIN and MMA7455_SCL_PIN  I2C pins for recoverBus()
+ *                     on cores without PIN_WIRE_SDA/SCL (e.g. ESP32)
+ * An instance of a transport not built in is never remapped to
+ * another one: begin() returns false and every transfer fails
+ * with mma_bus_error. */
+
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "Arduino.h"
+#if !defined(MMA7455_NO_I2C)
 #include "Wire.h"
+#endif
+#if !defined(MMA7455_NO_SPI)
 #include "SPI.h"
+#endif
 
 #elif defined(SPARK)
 #include "application.h"
 
+#else
+/* host build: replay of captured bus traffic only */
+#define MMA7455_HOST
+#if !defined(MMA7455_NO_I2C)
+#define MMA7455_NO_I2C
+#endif
+#if !defined(MMA7455_NO_SPI)
+#define MMA7455_NO_SPI
+#endif
+#undef  MMA7455_NO_CAPTURE
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#define LOW                     (0)
+#define HIGH                    (1)
+#define INPUT                   (0)
+#define OUTPUT                  (1)
+/* host clock, 1 = 1 us */
+uint32_t micros(void);
+
+#endif
+
+#if defined(MMA7455_NO_I2C) && defined(MMA7455_NO_SPI) && \
+    defined(MMA7455_NO_CAPTURE)
+#error "MMA_7455: no transport left, keep I2C, SPI or the replay"
 #endif
 
 /* I2C addresses */
@@ -64,6 +105,11 @@
 /* SPI operations */
 #define MMA7455_OPCODE_MASK     (0x01 << 6)
 
+/* Capture record: head, register, 1 to 32 data bytes */
+#define MMA7455_REC_WRITE       (0x01 << 7)
+#define MMA7455_REC_STATUS_MASK (0x03 << 5)
+#define MMA7455_REC_LEN_MASK    (0x1F << 0)
+
 /* 10bits Output X LBS */
 #define XOUTL_OFF               (0x00)
 #define XOUTL_MASK              (0xFF)
@@ -188,6 +234,7 @@
 #define CTL1_INTRG_PSL_LVL      (0x01 << 1)
 #define CTL1_INTRG_PSL_PSL      (0x02 << 1)
 #define CTL1_INTPIN             (0x01 << 0)
+#define CTL1_DFBW               (0x01 << 7)
 
 /* Control 2 */
 #define CTL2_OFF                (0x19)
@@ -255,20 +302,110 @@ typedef enum _ISR_MODE
   pulse_pulse = CTL1_INTRG_PSL_PSL
 } ISR_MODE;
 
+/* Output data rate */
+typedef enum _DATA_RATE
+{
+  odr_125hz = 0,         /* 62.5 Hz bandwidth */
+  odr_250hz = CTL1_DFBW  /* 125 Hz bandwidth */
+} DATA_RATE;
+
+/* Block sample format (element type) */
+typedef enum _SAMPLE_FORMAT
+{
+  fmt_raw = 0,     /* uint16_t, XOUTL | XOUTH << 8 as read */
+  fmt_8bit,        /* int8_t, current range */
+  fmt_10bit        /* int16_t, 8g */
+} SAMPLE_FORMAT;
+
+/* Bus transfer status */
+typedef enum _MMA7455_STATUS
+{
+  mma_ok = 0,
+  mma_nack,       /* address or data not acknowledged */
+  mma_timeout,    /* missing bytes or bus timeout */
+  mma_bus_error,  /* arbitration lost or unknown error */
+  mma_replay_mismatch, /* transfer differs from the capture */
+  mma_replay_end, /* capture exhausted */
+  mma_busy        /* shared bus held by another owner */
+} MMA7455_STATUS;
+
+/* Retries of a failed transfer, setRetries() caps there */
+#define MMA7455_MAX_RETRIES     (16)
+
+/* Device health */
+typedef enum _MMA7455_HEALTH
+{
+  health_ok = 0,
+  health_degraded,  /* errors recovered by retries */
+  health_failed     /* last transfer failed */
+} MMA7455_HEALTH;
+
+/* Self-test Z deflection, 10-bit (8g, 64 counts/g) */
+#define MMA7455_ST_Z_MIN        (32)
+#define MMA7455_ST_Z_MAX        (83)
+/* Self-test response (t_st) and turn-on (t_ru) time, max */
+#define MMA7455_ST_SETTLE_US    (20000UL)
+
+/* Self-test result */
+typedef struct _MMA7455_SELFTEST
+{
+  int16_t x;       /* deflection, 10-bit counts */
+  int16_t y;
+  int16_t z;
+  bool    pass;    /* z within datasheet limits */
+} MMA7455_SELFTEST;
+
+/* Timestamped 10-bit sample */
+typedef struct _MMA7455_SAMPLE
+{
+  uint32_t time;   /* 1 = 1 us */
+  int16_t  x;
+  int16_t  y;
+  int16_t  z;
+} MMA7455_SAMPLE;
+
+/* Calibration record, sealed by a CRC */
+#define MMA7455_CALIB_VERSION   (1)
+#define MMA7455_SCALE_ONE       (16384)
+
+typedef struct _MMA7455_CALIB
+{
+  uint8_t  version;
+  uint8_t  whoami;     /* device identity tag */
+  uint8_t  usrinf;
+  uint8_t  range;      /* 2, 4 or 8 g */
+  int16_t  offset[3];  /* offset drift registers */
+  int16_t  scale[3];   /* gain correction, 1 = 1/16384 */
+  uint16_t crc;        /* CRC-16/CCITT of the fields above */
+} MMA7455_CALIB;
+
 typedef enum _MMA7455_PROTOCOL
 {
   i2c_protocol,
-  spi_protocol
+  spi_protocol,
+  replay_protocol
 } MMA7455_PROTOCOL;
 
+class MMA7455_Bus;
+
+/* Integer square root, floor(sqrt(val)) */
+uint32_t MMA7455_isqrt(uint64_t val);
+/* CRC-16/CCITT (0x1021, init 0xFFFF) */
+uint16_t MMA7455_crc16(const uint8_t* data, uint16_t len);
+void    MMA7455_sealCalibration(MMA7455_CALIB* calib);
+bool    MMA7455_checkCalibration(const MMA7455_CALIB* calib);
+
 class MMA_7455
 {
   public:
     MMA_7455(MMA7455_PROTOCOL proto);
     MMA_7455(MMA7455_PROTOCOL proto, uint8_t pin_addr);
     
-    void    begin(void);
+    bool    begin(void);
+    bool    begin(const MMA7455_CALIB* calib);
+    bool    getCalibration(MMA7455_CALIB* calib);
     void    setChipSelectPin(uint8_t pin);
+    void    setBus(MMA7455_Bus* bus, uint16_t timeout_us = 1000);
     
     void    setSensitivity(int sensitivity);
     int     getSensitivity(void);
@@ -277,6 +414,16 @@ class MMA_7455
     MODE    getMode(void);
     
     void    setSelfTest(bool enable);
+    bool    runSelfTest(MMA7455_SELFTEST* result, uint8_t samples);
+    
+    void    setDataRate(DATA_RATE rate);
+    DATA_RATE getDataRate(void);
+    uint16_t getSamplePeriod(void);  /* 1 = 1 us */
+    void    setDataReadyPin(uint8_t pin);
+    bool    dataReady(void);
+    uint32_t getSampleTime(void);
+    uint16_t getOverrunCount(void);  /* STATUS polling only, not
+                                      * counted with a DRDY pin */
     
     void    enableDetectionXYZ(bool x, bool y, bool z);
     void    setThresholdMode(TH_MODE mode);
@@ -300,30 +447,101 @@ class MMA_7455
     void    getLevelDetection(bool* x, bool* y, bool* z);
     void    getPulseDetection(bool* x, bool* y, bool* z);
     void    getInterrupt(bool* int1, bool* int2);
+    uint8_t getDetectionSource(void);
     void    clearInterrupt(void);
     void    enableInterruptPins(bool enable);
     
     int8_t  readAxis8(char axis);
     void    readAxis8(int8_t* x, int8_t* y, int8_t* z);
-    float   readAxis8g(char axis);
-    void    readAxis8g(float* x, float* y, float* z);
     int16_t readAxis10(char axis);
     void    readAxis10(int16_t* x, int16_t* y, int16_t* z);
+#if !defined(MMA7455_NO_FLOAT)
+    float   readAxis8g(char axis);
+    void    readAxis8g(float* x, float* y, float* z);
     float   readAxis10g(char axis);
     void    readAxis10g(float* x, float* y, float* z);
+#endif
+    bool    readSample8(int8_t* x, int8_t* y, int8_t* z);
+    bool    readSample10(int16_t* x, int16_t* y, int16_t* z);
+    bool    readSample(MMA7455_SAMPLE* sample);
+    uint16_t readBlock(SAMPLE_FORMAT fmt, void* x, void* y, void* z,
+                       uint16_t n, uint16_t stride = 1);
+    
+    bool    isPresent(void);
+    bool    recoverBus(void);
+    void    setRetries(uint8_t retries);
+    MMA7455_STATUS getLastError(void);
+    MMA7455_HEALTH getHealth(void);
+    uint16_t getErrorCount(void);
+    void    resetHealth(void);
+    
+#if !defined(MMA7455_NO_CAPTURE)
+    void    setCapture(uint8_t* buff, uint16_t size);
+    uint16_t getCaptureLength(void);
+    bool    captureOverflow(void);
+    void    setReplay(const uint8_t* buff, uint16_t len);
+    bool    replayDone(void);
+#endif
     
     uint8_t readReg(uint8_t reg);
-    void    writeReg(uint8_t reg, uint8_t val);
+    MMA7455_STATUS readRegs(uint8_t reg, uint8_t* buff, uint8_t len);
+    MMA7455_STATUS writeReg(uint8_t reg, uint8_t val);
+    MMA7455_STATUS writeRegs(uint8_t reg, const uint8_t* buff, uint8_t len);
   
   private:
     MMA7455_PROTOCOL _protocol;
     uint8_t _i2c_address;
     int8_t  _spi_cs_pin;
+    int8_t  _drdy_pin;
+    uint16_t _period_us;
+    uint32_t _sample_us;
+    uint16_t _overruns;
+    uint8_t _status;
+    uint8_t _retries;
+    uint16_t _errors;
+    MMA7455_STATUS _last_error;
+    MMA7455_HEALTH _health;
+    MMA7455_Bus* _bus;
+    uint16_t _bus_timeout;
+#if !defined(MMA7455_NO_CAPTURE)
+    uint8_t* _capture;
+    uint16_t _capture_size;
+    uint16_t _capture_len;
+    bool     _capture_ovf;
+    const uint8_t* _replay;
+    uint16_t _replay_len;
+    uint16_t _replay_pos;
+#endif
     
-    uint8_t _readRegI2C(uint8_t reg);
+    void    _init(MMA7455_PROTOCOL proto);
+    void    _beginBus(void);
+    bool    _hasTransport(void);
+    bool    _busLock(void);
+    void    _busUnlock(void);
+    bool    _averageSample(uint8_t samples, int16_t* x, int16_t* y, int16_t* z,
+                           uint32_t first_us);
+    
+#if !defined(MMA7455_NO_I2C)
+    MMA7455_STATUS _readRegsI2C(uint8_t reg, uint8_t* buff, uint8_t len);
+    MMA7455_STATUS _writeRegsI2C(uint8_t reg, const uint8_t* buff, uint8_t len);
+    MMA7455_STATUS _i2cStatus(uint8_t err);
+#endif
+#if !defined(MMA7455_NO_SPI)
     uint8_t _readRegSPI(uint8_t reg);
-    void    _writeRegI2C(uint8_t reg, uint8_t val);
-    void    _writeRegSPI(uint8_t reg, uint8_t val);
+    MMA7455_STATUS _readRegsSPI(uint8_t reg, uint8_t* buff, uint8_t len);
+    MMA7455_STATUS _writeRegSPI(uint8_t reg, uint8_t val);
+    MMA7455_STATUS _writeRegsSPI(uint8_t reg, const uint8_t* buff, uint8_t len);
+#endif
+    MMA7455_STATUS _updateReg(uint8_t reg, uint8_t mask, uint8_t bits);
+#if !defined(MMA7455_NO_CAPTURE)
+    void    _record(bool write, uint8_t reg, const uint8_t* buff,
+                    uint8_t len, MMA7455_STATUS status);
+    bool    _replayNext(bool write, uint8_t reg, uint8_t len);
+    MMA7455_STATUS _replayRegs(bool write, uint8_t reg,
+                               uint8_t* buff, uint8_t len);
+#endif
+    void    _recover(MMA7455_STATUS status);
+    void    _track(MMA7455_STATUS status, uint8_t attempt);
     
 };
 
@@ -0,0 +1,58 @@
+/**
+ *  Name:      MMA7455_Alignment
+ *  Desc.:     Aligned samples of two accelerometers
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Two MMA7455 share the I2C bus, one with its address pin
+ *    tied low (0x1D) and one tied high (0x1C). Their streams
+ *    are aligned on a common 4 ms grid, and the Z difference
+ *    between both sensors is displayed for each frame, along
+ *    with the measured sample periods.
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+#include <MMA7455_Align.h>
+
+MMA_7455 accel1 = MMA_7455(i2c_protocol, MMA7455_I2C_ADDR1);
+MMA_7455 accel2 = MMA_7455(i2c_protocol, MMA7455_I2C_ADDR2);
+
+MMA7455_Align align = MMA7455_Align();
+
+void setup()
+{
+  /* Set serial baud rate */
+  Serial.begin(115200);
+  /* Start accelerometers */
+  accel1.begin();
+  accel1.setMode(measure);
+  accel1.setDataRate(odr_250hz);
+  accel2.begin();
+  accel2.setMode(measure);
+  accel2.setDataRate(odr_250hz);
+  /* 2 streams on a 4 ms grid */
+  align.begin(2, 4000);
+}
+
+void loop()
+{
+  MMA7455_FRAME frame;
+  
+  align.acquire(0, &accel1);
+  align.acquire(1, &accel2);
+  
+  while(align.getFrame(&frame))
+  {
+    Serial.print(frame.time, DEC);    Serial.print("\t");
+    Serial.print(frame.z[0] - frame.z[1], DEC);   Serial.print("\t");
+    Serial.print(align.getPeriod(0) / 256, DEC);  Serial.print("\t");
+    Serial.println(align.getPeriod(1) / 256, DEC);
+  }
+}
@@ -30,6 +30,15 @@
  *    in setAxisOffset(x,y,z), and run the application. The output
  *    should be close to X = 0, Y = 0, Z = 64.
  *
+ *    The calibration record is also saved in the EEPROM at
+ *    address 0. Restore it at boot with:
+ *      MMA7455_loadCalibration(&calib, &MMA7455_EEPROM_STORE, 0);
+ *      accel.begin(&calib);
+ *    which writes the registers only when they differ, and
+ *    falls back on begin() when there is no valid record.
+ *    The SAM core (Arduino Due) has no EEPROM: the record is
+ *    not saved there, pass your own MMA7455_STORE instead.
+ *
  *    It is expected for the sensor to report slight variations of one
  *    or two points, even when the accelerometer is not in motion.
  *
@@ -45,6 +54,11 @@
 #endif
 
 #include <MMA_7455.h>
+#include <MMA7455_Calib.h>
+/* No EEPROM library on the SAM core (Arduino Due) */
+#if !defined(ARDUINO_ARCH_SAM)
+#include <MMA7455_EEPROM.h>
+#endif
 
 /* Case 1: Accelerometer on the I2C bus (most common) */
 MMA_7455 accel = MMA_7455(i2c_protocol);
@@ -60,6 +74,10 @@ void setup()
 {
   /* Set serial baud rate */
   Serial.begin(9600);
+#if defined(MMA7455_EEPROM_COMMIT)
+  /* EEPROM emulated in flash: the sketch sets its size */
+  EEPROM.begin(512);
+#endif
   /* Start accelerometer */
   accel.begin();
   /* Set accelerometer sensibility to 2g */
@@ -119,6 +137,17 @@ void loop()
     Serial.print(", "); Serial.print(yc, DEC);
     Serial.print(", "); Serial.print(zc, DEC);
     Serial.print(");\n");
+    Serial.print("-----------------------------\n");
+    /* Save the calibration record */
+#if !defined(ARDUINO_ARCH_SAM)
+    MMA7455_CALIB calib;
+    if(accel.getCalibration(&calib) && MMA7455_saveCalibration(&calib, &MMA7455_EEPROM_STORE, 0))
+      Serial.print("Saved in EEPROM.\n");
+    else
+      Serial.print("Save failure.\n");
+#else
+    Serial.print("No EEPROM, not saved.\n");
+#endif
     Serial.print("-----------------------------\n");
     Serial.print("DONE. -----------------------\n");
     while(1);
@@ -0,0 +1,52 @@
+/**
+ *  Name:      MMA7455_AutoRange
+ *  Desc.:     8-bit values with automatic range switching
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Starts at 2g for the best resolution on gentle motion and
+ *    widens up to 8g on shocks, then comes back once quiet.
+ *    Values are displayed in 1/64 g whatever the range, along
+ *    with the range they were taken at.
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+#include <MMA7455_AutoRange.h>
+
+/* Case 1: Accelerometer on the I2C bus (most common) */
+MMA_7455 accel = MMA_7455(i2c_protocol);
+/* Case 2: Accelerometer on the SPI bus with CS on pin 2 */
+// MMA_7455 accel = MMA_7455(spi_protocol, A2);
+
+MMA7455_AutoRange autorange = MMA7455_AutoRange(&accel);
+
+void setup()
+{
+  /* Set serial baud rate */
+  Serial.begin(9600);
+  /* Start accelerometer */
+  accel.begin();
+  accel.setSensitivity(2);
+  accel.setMode(measure);
+  autorange.begin();
+}
+
+void loop()
+{
+  MMA7455_RANGED sample;
+  
+  if(!autorange.readSample(&sample))  return;
+  
+  Serial.print(sample.range, DEC);  Serial.print("g\t");
+  Serial.print(sample.x, DEC);      Serial.print("\t");
+  Serial.print(sample.y, DEC);      Serial.print("\t");
+  Serial.print(sample.z, DEC);
+  Serial.println(sample.clipped ? "\tclipped" : "");
+}
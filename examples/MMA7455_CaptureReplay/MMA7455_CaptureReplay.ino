@@ -0,0 +1,94 @@
+/**
+ *  Name:      MMA7455_CaptureReplay
+ *  Desc.:     Record the bus traffic and replay it offline
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    The first run reads 32 samples from the accelerometer
+ *    while every register transfer is recorded in a RAM buffer.
+ *    A second driver instance then replays the capture without
+ *    touching the bus: it must return the very same samples,
+ *    at full CPU speed.
+ *
+ *    The capture is dumped in hexadecimal on the serial console.
+ *    Paste it in a host program built against the library
+ *    (without ARDUINO defined, only the replay is compiled)
+ *    to reproduce a field unit register by register.
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+
+#define SAMPLES   32
+
+/* Case 1: Accelerometer on the I2C bus (most common) */
+MMA_7455 accel = MMA_7455(i2c_protocol);
+/* Case 2: Accelerometer on the SPI bus with CS on pin 2 */
+// MMA_7455 accel = MMA_7455(spi_protocol, A2);
+/* Replay of the capture */
+MMA_7455 replay = MMA_7455(replay_protocol);
+
+uint8_t capture[640];
+int16_t xs[SAMPLES], ys[SAMPLES], zs[SAMPLES];
+
+void setup()
+{
+  int16_t  x10, y10, z10;
+  uint16_t i;
+  uint16_t errors = 0;
+  uint32_t t0, t1;
+  
+  /* Set serial baud rate */
+  Serial.begin(9600);
+  
+  /* Record everything from begin() on */
+  accel.setCapture(capture, sizeof(capture));
+  accel.begin();
+  accel.setSensitivity(2);
+  accel.setMode(measure);
+  for(i = 0; i < SAMPLES; i++)
+  {
+    while(!accel.readSample10(&xs[i], &ys[i], &zs[i]));
+  }
+  if(accel.captureOverflow())   Serial.println("Capture buffer too small");
+  
+  /* Same calls on the replay instance */
+  t0 = micros();
+  replay.setReplay(capture, accel.getCaptureLength());
+  replay.begin();
+  replay.setSensitivity(2);
+  replay.setMode(measure);
+  for(i = 0; i < SAMPLES; i++)
+  {
+    while(!replay.readSample10(&x10, &y10, &z10)
+          && replay.getLastError() == mma_ok);
+    if(x10 != xs[i] || y10 != ys[i] || z10 != zs[i])  errors++;
+  }
+  t1 = micros();
+  
+  Serial.print("Capture: ");  Serial.print(accel.getCaptureLength(), DEC);
+  Serial.println(" bytes");
+  Serial.print("Replay: ");   Serial.print(t1 - t0, DEC);
+  Serial.print(" us, ");      Serial.print(errors, DEC);
+  Serial.println(" mismatch");
+  if(!replay.replayDone())      Serial.println("Replay incomplete");
+  
+  /* Dump the capture */
+  for(i = 0; i < accel.getCaptureLength(); i++)
+  {
+    if(capture[i] < 0x10)   Serial.print("0");
+    Serial.print(capture[i], HEX);
+    Serial.print((i % 16 == 15) ? "\n" : " ");
+  }
+  Serial.println();
+}
+
+void loop()
+{
+}
@@ -0,0 +1,54 @@
+/**
+ *  Name:      MMA7455_DeadBand
+ *  Desc.:     Report only the samples that changed
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    A sample is displayed when an axis moved by more than
+ *    4 counts (about 0.06g in 10-bit) or at least once every
+ *    5 seconds, along with the number of samples suppressed
+ *    since the previous one.
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+#include <MMA7455_DeadBand.h>
+
+/* Case 1: Accelerometer on the I2C bus (most common) */
+MMA_7455 accel = MMA_7455(i2c_protocol);
+/* Case 2: Accelerometer on the SPI bus with CS on pin 2 */
+// MMA_7455 accel = MMA_7455(spi_protocol, A2);
+
+MMA7455_DeadBand deadband = MMA7455_DeadBand();
+
+void setup()
+{
+  /* Set serial baud rate */
+  Serial.begin(9600);
+  /* Start accelerometer */
+  accel.begin();
+  accel.setMode(measure);
+  /* 4 counts dead band, 5 s heartbeat */
+  deadband.begin(4, 5000);
+}
+
+void loop()
+{
+  MMA7455_SAMPLE sample;
+  REPORT_REASON  reason;
+  
+  reason = deadband.acquire(&accel, &sample);
+  if(reason == report_none)   return;
+  
+  Serial.print(reason == report_heartbeat ? "Alive  " : "Motion ");
+  Serial.print(sample.x, DEC);  Serial.print("\t");
+  Serial.print(sample.y, DEC);  Serial.print("\t");
+  Serial.print(sample.z, DEC);  Serial.print("\tsuppressed: ");
+  Serial.println(deadband.getSuppressed(), DEC);
+}
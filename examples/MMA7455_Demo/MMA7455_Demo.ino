@@ -57,6 +57,8 @@ void setup()
   Serial.begin(9600);
   /* Start accelerometer */
   accel.begin();
+  /* Verify accelerometer answers on the bus - optional */
+  if(!accel.isPresent())            Serial.println("Accelerometer not found");
   /* Set accelerometer sensibility */
   accel.setSensitivity(2);
   /* Verify sensibility - optional */
@@ -65,6 +67,9 @@ void setup()
   accel.setMode(measure);
   /* Verify accelerometer mode - optional */
   if(accel.getMode() != measure)    Serial.println("Set mode failure");
+  /* Check the sensing element - optional */
+  MMA7455_SELFTEST st;
+  if(!accel.runSelfTest(&st, 4) || !st.pass)  Serial.println("Self-test failure");
   /* Set axis offsets */
   /* Note: the offset is hardware specific
    * and defined thanks to the auto-calibration example. */
@@ -0,0 +1,75 @@
+/**
+ *  Name:      MMA7455_FallDetection
+ *  Desc.:     Free fall, impact and rest events
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Drop the accelerometer on a cushion: the free fall, the
+ *    impact (with its peak in 1/64 g) and the rest are displayed
+ *    with their time. The detector runs on the samples at the
+ *    full 250 Hz rate in measurement mode.
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+#include <MMA7455_FallDetector.h>
+
+/* Case 1: Accelerometer on the I2C bus (most common) */
+MMA_7455 accel = MMA_7455(i2c_protocol);
+/* Case 2: Accelerometer on the SPI bus with CS on pin 2 */
+// MMA_7455 accel = MMA_7455(spi_protocol, A2);
+
+MMA7455_FallDetector detector = MMA7455_FallDetector();
+
+void setup()
+{
+  /* Set serial baud rate */
+  Serial.begin(9600);
+  /* Start accelerometer */
+  accel.begin();
+  accel.setMode(measure);
+  accel.setDataRate(odr_250hz);
+  /* Free fall under 0.3g for 80 ms, impact over 2g within 500 ms */
+  detector.setFreeFall(19, 80);
+  detector.setImpact(128, 500);
+}
+
+void loop()
+{
+  MMA7455_SAMPLE sample;
+  MMA7455_FALL   event;
+  
+  switch(detector.acquire(&accel, &sample))
+  {
+    case fall_freefall_event:
+      Serial.print("Free fall");
+      break;
+    case fall_impact_event:
+      Serial.print("Impact");
+      break;
+    case fall_rest_event:
+      Serial.print("Rest");
+      break;
+    case fall_timeout_event:
+      Serial.print("Timeout");
+      break;
+    default:
+      return;
+  }
+  
+  detector.getEvent(&event);
+  Serial.print(" at ");     Serial.print(event.time / 1000, DEC);
+  Serial.print(" ms for "); Serial.print(event.duration / 1000, DEC);
+  Serial.print(" ms");
+  if(event.peak)
+  {
+    Serial.print(", peak ");  Serial.print(event.peak, DEC);
+  }
+  Serial.println();
+}
@@ -0,0 +1,60 @@
+/**
+ *  Name:      MMA7455_Oversampling
+ *  Desc.:     Trade output rate for resolution
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Each output averages 2^6 = 64 conversions, so at 125 Hz
+ *    about 2 values per second are displayed, with 3 extra
+ *    fractional bits: 1g reads 64 * 8 = 512.
+ *    The noise floor is the standard error of each output,
+ *    in 1/256 of a 10-bit count.
+ *
+ *    The code expects to have the axis offset
+ *    configured. To get the offset of your
+ *    accelerometer, run MMA7455_AutoCalibration.
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+#include <MMA7455_Oversampler.h>
+
+/* Case 1: Accelerometer on the I2C bus (most common) */
+MMA_7455 accel = MMA_7455(i2c_protocol);
+/* Case 2: Accelerometer on the SPI bus with CS on pin 2 */
+// MMA_7455 accel = MMA_7455(spi_protocol, A2);
+
+MMA7455_Oversampler os = MMA7455_Oversampler(&accel);
+
+int32_t  xos, yos, zos;
+uint16_t xnoise, ynoise, znoise;
+
+void setup()
+{
+  /* Set serial baud rate */
+  Serial.begin(9600);
+  /* Start accelerometer */
+  accel.begin();
+  accel.setMode(measure);
+  accel.setAxisOffset(0, 0, 0);
+  /* 2^6 conversions per output */
+  os.setOversampling(6);
+}
+
+void loop()
+{
+  if(os.readAxis10(&xos, &yos, &zos))
+  {
+    os.getNoiseFloor(&xnoise, &ynoise, &znoise);
+    Serial.print("X: ");        Serial.print(xos, DEC);
+    Serial.print("\tY: ");      Serial.print(yos, DEC);
+    Serial.print("\tZ: ");      Serial.print(zos, DEC);
+    Serial.print("\tNoise Z: ");  Serial.println(znoise, DEC);
+  }
+}
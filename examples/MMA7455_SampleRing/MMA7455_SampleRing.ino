@@ -0,0 +1,82 @@
+/**
+ *  Name:      MMA7455_SampleRing
+ *  Desc.:     Share the sample stream between several consumers
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Every new sample is pushed once in a ring buffer with
+ *    its timestamp and sequence number. Two independent
+ *    consumers read it at their own pace:
+ *    - a peak detector that reads every sample in place,
+ *    - a slow console logger that only wakes up every 500ms
+ *      and reports how many samples it missed.
+ *
+ *    On a Linux host the same ring can be placed in a file
+ *    mapped from /dev/shm and read by other processes with
+ *    MMA7455_Ring::attach().
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+#include <MMA7455_Ring.h>
+
+/* Case 1: Accelerometer on the I2C bus (most common) */
+MMA_7455 accel = MMA_7455(i2c_protocol);
+/* Case 2: Accelerometer on the SPI bus with CS on pin 2 */
+// MMA_7455 accel = MMA_7455(spi_protocol, A2);
+
+uint8_t ring_mem[MMA7455_RING_SIZE(16)];
+MMA7455_Ring ring;
+MMA7455_RING_READER peak_reader;
+MMA7455_RING_READER log_reader;
+
+MMA7455_SAMPLE sample;
+int16_t  zpeak = 0;
+uint32_t last_log = 0;
+
+void setup()
+{
+  /* Set serial baud rate */
+  Serial.begin(9600);
+  /* Start accelerometer */
+  accel.begin();
+  accel.setSensitivity(2);
+  accel.setMode(measure);
+  accel.setDataRate(odr_125hz);
+  /* Format the ring and open the consumers */
+  ring.begin(ring_mem, sizeof(ring_mem));
+  ring.openReader(&peak_reader);
+  ring.openReader(&log_reader);
+}
+
+void loop()
+{
+  const MMA7455_SAMPLE* s;
+  
+  /* Producer: one bus burst per conversion */
+  ring.acquire(&accel);
+  
+  /* Consumer 1: zero-copy, every sample */
+  while((s = ring.peek(&peak_reader)) != NULL)
+  {
+    int16_t z = s->z;
+    if(ring.release(&peak_reader) && z > zpeak)   zpeak = z;
+  }
+  
+  /* Consumer 2: slow, latest sample only */
+  if(millis() - last_log >= 500)
+  {
+    last_log = millis();
+    while(ring.read(&log_reader, &sample));
+    Serial.print("T: ");        Serial.print(sample.time, DEC);
+    Serial.print("\tZ: ");      Serial.print(sample.z, DEC);
+    Serial.print("\tZpeak: ");  Serial.print(zpeak, DEC);
+    Serial.print("\tLost: ");   Serial.println(log_reader.lost, DEC);
+  }
+}
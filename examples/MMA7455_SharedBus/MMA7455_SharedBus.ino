@@ -0,0 +1,94 @@
+/**
+ *  Name:      MMA7455_SharedBus
+ *  Desc.:     Two accelerometers on one SPI bus, one of them
+ *             read from an interrupt handler
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    The first accelerometer (CS on pin 9) has its INT1/DRDY
+ *    pin on pin 2 and is read in the interrupt handler. The
+ *    second one (CS on pin 10) is read from the main loop.
+ *    Both take the shared bus for each burst: the handler never
+ *    splits a transfer of the main loop, it gets mma_busy and
+ *    the main loop reads the sample instead (DRDY stays high
+ *    until the outputs are read, no new edge would come).
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+#include <MMA7455_Bus.h>
+
+#define DRDY_PIN    2
+
+MMA_7455 accel1 = MMA_7455(spi_protocol, 9);
+MMA_7455 accel2 = MMA_7455(spi_protocol, 10);
+MMA7455_Bus bus = MMA7455_Bus();
+
+volatile int16_t  z1      = 0;
+volatile bool     pending = false;
+volatile uint16_t busy    = 0;
+
+void readFirst()
+{
+  int16_t z = 0;
+  
+  accel1.readAxis10(NULL, NULL, &z);
+  if(accel1.getLastError() == mma_ok)
+  {
+    z1      = z;
+    pending = false;
+  }
+  else
+  {
+    pending = true;
+  }
+}
+
+void onDataReady()
+{
+  /* never wait in a handler: timeout 0 */
+  readFirst();
+  if(pending)   busy++;
+}
+
+void setup()
+{
+  /* Set serial baud rate */
+  Serial.begin(9600);
+  /* Start accelerometers */
+  accel1.begin();
+  accel1.setMode(measure);
+  accel1.setBus(&bus, 0);
+  accel2.begin();
+  accel2.setMode(measure);
+  accel2.setBus(&bus, 1000);
+  /* SPI used from the handler */
+  SPI.usingInterrupt(digitalPinToInterrupt(DRDY_PIN));
+  attachInterrupt(digitalPinToInterrupt(DRDY_PIN), onDataReady, RISING);
+}
+
+void loop()
+{
+  int16_t z2 = 0;
+  
+  /* sample left by the handler */
+  if(pending)
+  {
+    noInterrupts();
+    readFirst();
+    interrupts();
+  }
+  if(!accel2.readSample10(NULL, NULL, &z2))   return;
+  
+  Serial.print("Z1: ");         Serial.print(z1, DEC);
+  Serial.print("\tZ2: ");       Serial.print(z2, DEC);
+  Serial.print("\tbusy: ");     Serial.print(busy, DEC);
+  Serial.print("\tcontention: ");
+  Serial.println(bus.getContention(), DEC);
+}
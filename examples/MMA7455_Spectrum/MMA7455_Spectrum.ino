@@ -0,0 +1,67 @@
+/**
+ *  Name:      MMA7455_Spectrum
+ *  Desc.:     Vibration spectrum of the Z axis
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    A block of 128 samples is acquired at 250 Hz, then
+ *    transformed in place. The 3 strongest spectral peaks are
+ *    displayed with their frequency (bin * 250 / 128 Hz) and
+ *    their amplitude in 10-bit counts.
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+#include <MMA7455_FFT.h>
+
+#define BLOCK   128
+
+/* Case 1: Accelerometer on the I2C bus (most common) */
+MMA_7455 accel = MMA_7455(i2c_protocol);
+/* Case 2: Accelerometer on the SPI bus with CS on pin 2 */
+// MMA_7455 accel = MMA_7455(spi_protocol, A2);
+
+MMA7455_FFT fft = MMA7455_FFT(BLOCK, fft_hann);
+
+int16_t      zblock[BLOCK];
+MMA7455_PEAK peaks[3];
+
+void setup()
+{
+  /* Set serial baud rate */
+  Serial.begin(9600);
+  /* Start accelerometer */
+  accel.begin();
+  accel.setMode(measure);
+  accel.setDataRate(odr_250hz);
+}
+
+void loop()
+{
+  uint16_t* mags;
+  uint16_t  i;
+  uint8_t   n;
+  
+  /* Acquire one block, Z axis only */
+  if(accel.readBlock(fmt_10bit, NULL, NULL, zblock, BLOCK) != BLOCK)  return;
+  
+  /* Spectrum, in place */
+  mags = fft.transform(zblock);
+  n    = fft.getPeaks(mags, peaks, 3);
+  
+  Serial.print("Mean Z: ");   Serial.print(mags[0] / 16, DEC);
+  for(i = 0; i < n; i++)
+  {
+    Serial.print("\t");
+    Serial.print(peaks[i].bin * 250UL / BLOCK, DEC);
+    Serial.print(" Hz: ");
+    Serial.print(peaks[i].mag / 16, DEC);
+  }
+  Serial.println();
+}
@@ -0,0 +1,68 @@
+/**
+ *  Name:      MMA7455_TriggeredCapture
+ *  Desc.:     Capture of the samples around a shock
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    The trigger fires when any axis reaches 1.5g (96 counts
+ *    in 10-bit). The 32 samples before the shock and the 96
+ *    samples from the shock on are displayed with their time
+ *    relative to the trigger, then the trigger is re-armed.
+ *
+ */
+
+#if defined(ARDUINO)
+/* Mandatory includes for Arduino */
+#include <SPI.h>
+#include <Wire.h>
+#endif
+
+#include <MMA_7455.h>
+#include <MMA7455_Trigger.h>
+
+#define PRE     32
+#define POST    96
+
+/* Case 1: Accelerometer on the I2C bus (most common) */
+MMA_7455 accel = MMA_7455(i2c_protocol);
+/* Case 2: Accelerometer on the SPI bus with CS on pin 2 */
+// MMA_7455 accel = MMA_7455(spi_protocol, A2);
+
+MMA7455_SAMPLE  samples[PRE + POST];
+MMA7455_Trigger trig = MMA7455_Trigger(samples, PRE + POST);
+
+void setup()
+{
+  /* Set serial baud rate */
+  Serial.begin(9600);
+  /* Start accelerometer */
+  accel.begin();
+  accel.setMode(measure);
+  accel.setDataRate(odr_250hz);
+  /* Software trigger at 1.5g, then wait for the shock */
+  trig.begin(PRE, POST);
+  trig.setThreshold(96);
+  trig.arm(&accel);
+}
+
+void loop()
+{
+  const MMA7455_SAMPLE* s;
+  MMA7455_CAPTURE       cap;
+  uint16_t              i;
+  
+  if(!trig.acquire(&accel))   return;
+  
+  trig.getCapture(&cap);
+  Serial.print("Trigger, pre: ");   Serial.print(cap.pre, DEC);
+  Serial.print(" post: ");          Serial.println(cap.post, DEC);
+  for(i = 0; i < cap.pre + cap.post; i++)
+  {
+    s = trig.getSample(i);
+    Serial.print((int32_t)(s->time - cap.time), DEC);   Serial.print("\t");
+    Serial.print(s->x, DEC);   Serial.print("\t");
+    Serial.print(s->y, DEC);   Serial.print("\t");
+    Serial.println(s->z, DEC);
+  }
+  trig.arm(&accel);
+}
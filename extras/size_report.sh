@@ -0,0 +1,67 @@
+#!/bin/bash
+#
+#  Name:      size_report.sh
+#  Desc.:     Flash/RAM footprint of every example per library
+#             configuration, built with PlatformIO
+#  License:   GPLv2
+#
+#  Usage:     extras/size_report.sh [board] [output]
+#             (defaults: uno, extras/size_report.md)
+#
+#  Each example is built once per footprint option set below.
+#  Combinations an example does not support (e.g. the float
+#  demo in an integer only build) are reported as n/a, and so
+#  are builds without the transport the example instantiates
+#  (such an instance would only fail at run time).
+#
+
+set -u
+
+BOARD="${1:-uno}"
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+OUTPUT="${2:-$ROOT/extras/size_report.md}"
+
+CONFIGS=(
+  "full:"
+  "i2c-only:-DMMA7455_NO_SPI"
+  "spi-only:-DMMA7455_NO_I2C"
+  "i2c-int:-DMMA7455_NO_SPI -DMMA7455_NO_FLOAT"
+  "spi-int:-DMMA7455_NO_I2C -DMMA7455_NO_FLOAT"
+  "i2c-minimal:-DMMA7455_NO_SPI -DMMA7455_NO_FLOAT -DMMA7455_NO_CAPTURE"
+)
+
+# true when the sketch instantiates the transport (comments skipped)
+uses()
+{
+  grep -q "^[^/]*$1" "$2"/*.ino
+}
+
+# "used 1234 bytes" from the PlatformIO memory summary
+usage()
+{
+  grep "^$1:" | sed -n 's/.*used \([0-9]*\) bytes.*/\1/p'
+}
+
+{
+  echo "# MMA_7455 size report ($BOARD)"
+  echo
+  echo "| Example | Configuration | Flash (bytes) | RAM (bytes) |"
+  echo "|---------|---------------|---------------|-------------|"
+  for e in "$ROOT"/examples/*; do
+    for c in "${CONFIGS[@]}"; do
+      name="${c%%:*}"
+      flags="${c#*:}"
+      if { [[ "$flags" == *MMA7455_NO_SPI* ]] && uses spi_protocol "$e"; } ||
+         { [[ "$flags" == *MMA7455_NO_I2C* ]] && uses i2c_protocol "$e"; }
+      then
+        echo "| $(basename "$e") | $name | n/a | n/a |"
+        continue
+      fi
+      log="$(platformio ci --board="$BOARD" --lib="$ROOT" \
+             --project-option="build_flags=$flags" "$e"/*.ino 2>&1)"
+      flash="$(echo "$log" | usage Flash)"
+      ram="$(echo "$log" | usage RAM)"
+      echo "| $(basename "$e") | $name | ${flash:-n/a} | ${ram:-n/a} |"
+    done
+  done
+} | tee "$OUTPUT"
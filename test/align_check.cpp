@@ -0,0 +1,121 @@
+/**
+ *  Name:      align_check
+ *  Desc.:     Host check of MMA7455_Align
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Two synthetic streams of a 7 Hz sine, nominal 4 ms period,
+ *    0.25% slow and 0.25% fast (0.5% apart), with 0 to 150 us
+ *    of timestamp jitter, a time base wrapping around 2^32 and
+ *    one sample dropped on the second stream. Checks that the
+ *    tracked periods converge, that the dropped sample is the
+ *    only one counted as missed, that no grid time is skipped,
+ *    and that the frames match the sine at the grid time (with
+ *    a looser bound next to the dropped sample, where the sine
+ *    is interpolated linearly over two periods).
+ *
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "MMA7455_Align.h"
+#include "check.h"
+
+#define GRID_US     (4000)
+#define SAMPLES     (20000)     /* per stream */
+#define SETTLE      (500)       /* samples before checking */
+#define DROPPED     (7455)      /* sample index dropped on stream 1 */
+#define JITTER_US   (150)
+#define ORIGIN_US   (4294000000.0)  /* wraps after ~240 samples */
+
+#define PERIOD_TOL  (2.0)       /* us, 0.05% */
+#define VALUE_TOL   (3.0)       /* counts */
+#define GAP_TOL     (7.0)       /* counts, linear across 8 ms of sine */
+
+static double signal(double t)
+{
+  return 400.0 * sin(2 * M_PI * 7.0 * t / 1e6);
+}
+
+int main(void)
+{
+  MMA7455_Align  align;
+  MMA7455_SAMPLE sample;
+  MMA7455_FRAME  frame;
+  const double   period[2] = {GRID_US * 1.0025, GRID_US * 0.9975};
+  const double   phase[2]  = {1000.3, 2777.1};
+  uint32_t       index[2]  = {0, 0};
+  double         t      = 0;
+  double         err    = 0;
+  double         max_value  = 0;
+  double         max_period = 0;
+  double         start  = 0;
+  double         elapsed = 0;
+  uint32_t       frames = 0;
+  uint8_t        i      = 0;
+  
+  srand(7455);
+  CHECK(align.begin(2, GRID_US));
+  
+  start = now_us();
+  while(index[0] < SAMPLES || index[1] < SAMPLES)
+  {
+    /* next sample in time order */
+    i = (phase[0] + index[0] * period[0] < phase[1] + index[1] * period[1]) ? 0 : 1;
+    t = phase[i] + index[i] * period[i];
+    if(i == 1 && index[1] == DROPPED)
+    {
+      index[1]++;
+      continue;
+    }
+    
+    sample.time = (uint32_t)fmod(ORIGIN_US + t + rand() % JITTER_US, 4294967296.0);
+    sample.x    = (int16_t)lround(signal(t));
+    sample.y    = (int16_t)(index[i] & 0x1FF);
+    sample.z    = i;
+    CHECK(align.add(i, &sample));
+    index[i]++;
+    
+    while(align.getFrame(&frame))
+    {
+      frames++;
+      CHECK(frame.count == 2);
+      if(index[0] < SETTLE || index[1] < SETTLE)  continue;
+      
+      /* tracked times carry the mean jitter */
+      t = fmod((double)frame.time - ORIGIN_US + 4294967296.0, 4294967296.0) - JITTER_US / 2.0;
+      err = fabs(frame.x[0] - signal(t));
+      if(err > max_value)   max_value = err;
+      err = fabs(frame.x[1] - signal(t));
+      if(fabs(t - (phase[1] + DROPPED * period[1])) < period[1])
+      {
+        CHECK(err <= GAP_TOL);
+        continue;
+      }
+      if(err > max_value)   max_value = err;
+    }
+    
+    if(index[0] >= SETTLE && index[1] >= SETTLE)
+    {
+      err = fmax(fabs(align.getPeriod(0) / 256.0 - period[0]),
+                 fabs(align.getPeriod(1) / 256.0 - period[1]));
+      if(err > max_period)  max_period = err;
+    }
+  }
+  elapsed = now_us() - start;
+  
+  CHECK(max_period <= PERIOD_TOL);
+  CHECK(max_value <= VALUE_TOL);
+  CHECK(align.getMissed(0) == 0);
+  CHECK(align.getMissed(1) == 1);
+  CHECK(align.getLate() == 0);
+  /* one frame per grid step over the common span */
+  CHECK(frames > SAMPLES * 0.99);
+  
+  printf("period: %.3f us and %.3f us, max error %.3f us\n",
+         align.getPeriod(0) / 256.0, align.getPeriod(1) / 256.0, max_period);
+  printf("frames: %lu, max error %.2f counts, missed %u and %u, late %u\n",
+         (unsigned long)frames, max_value, align.getMissed(0), align.getMissed(1), align.getLate());
+  printf("%.1f ns per sample added, frames included\n", elapsed * 1e3 / (2 * SAMPLES - 1));
+  return check_result();
+}
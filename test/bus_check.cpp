@@ -0,0 +1,198 @@
+/**
+ *  Name:      bus_check
+ *  Desc.:     Host stress check of MMA7455_Bus
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Threads take the same bus: the counter updated under the
+ *    lock must not lose any increment, no two owners may hold
+ *    it at once, and getContention() must match the attempts
+ *    found busy. Then accelerometers replaying
+ *    fixtures/replay_basic.bin share a bus from several threads
+ *    and an owner with a timeout of 0 gets mma_busy.
+ *
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include "MMA7455_Bus.h"
+#include "check.h"
+
+#define THREADS     4
+#define LOCKS       200000UL    /* per thread */
+#define REPLAYS     200         /* per thread */
+
+/* counts the owners holding the bus at once */
+class CheckedBus : public MMA7455_Bus
+{
+  public:
+    int overlaps;
+    int holders;
+    
+    CheckedBus(void) : overlaps(0), holders(0) {}
+    
+    bool lock(uint16_t timeout_us)
+    {
+      if(!MMA7455_Bus::lock(timeout_us))  return false;
+      if(__atomic_add_fetch(&this->holders, 1, __ATOMIC_RELAXED) != 1)
+      {
+        __atomic_add_fetch(&this->overlaps, 1, __ATOMIC_RELAXED);
+      }
+      return true;
+    }
+    
+    void unlock(void)
+    {
+      __atomic_sub_fetch(&this->holders, 1, __ATOMIC_RELAXED);
+      MMA7455_Bus::unlock();
+    }
+};
+
+static MMA7455_Bus    bus;
+static volatile int   owner   = -1;
+static uint32_t       counter = 0;    /* plain, guarded by the bus */
+static uint32_t       overlaps = 0;
+
+typedef struct
+{
+  int      id;
+  uint32_t busy;
+} LOCKER;
+
+static void* locker(void* arg)
+{
+  LOCKER*  l = (LOCKER*)arg;
+  uint32_t i = 0;
+  
+  for(i = 0; i < LOCKS; i++)
+  {
+    while(!bus.tryLock())
+    {
+      l->busy++;
+      sched_yield();
+    }
+    if(owner != -1)   overlaps++;
+    owner = l->id;
+    counter++;
+    /* widen the window for another owner */
+    if((i & 0xFF) == 0)   sched_yield();
+    if(owner != l->id)  overlaps++;
+    owner = -1;
+    bus.unlock();
+  }
+  return NULL;
+}
+
+static void check_lock(void)
+{
+  pthread_t threads[THREADS];
+  LOCKER    lockers[THREADS];
+  uint32_t  busy    = 0;
+  double    start   = 0;
+  double    elapsed = 0;
+  int       i = 0;
+  
+  start = now_us();
+  for(i = 0; i < THREADS; i++)
+  {
+    lockers[i].id   = i;
+    lockers[i].busy = 0;
+    pthread_create(&threads[i], NULL, locker, &lockers[i]);
+  }
+  for(i = 0; i < THREADS; i++)
+  {
+    pthread_join(threads[i], NULL);
+    busy += lockers[i].busy;
+  }
+  elapsed = now_us() - start;
+  
+  CHECK(counter == THREADS * LOCKS);
+  CHECK(overlaps == 0);
+  CHECK(!bus.isLocked());
+  CHECK(bus.getContention() == ((busy > 0xFFFF) ? 0xFFFF : busy));
+  printf("lock: %d threads, %lu locks, %lu found busy, %.1f ns/lock\n",
+         THREADS, (unsigned long)(THREADS * LOCKS), (unsigned long)busy,
+         elapsed * 1e3 / (THREADS * LOCKS));
+  return;
+}
+
+static const uint8_t* capture = NULL;
+static uint16_t       capture_len = 0;
+static CheckedBus     shared;
+
+static void* replayer(void* arg)
+{
+  MMA_7455 accel(replay_protocol);
+  int16_t  x = 0, y = 0, z = 0;
+  int16_t  block[3 * 32];
+  int*     errors = (int*)arg;
+  int      run = 0;
+  int      i   = 0;
+  
+  /* the replay spins while another thread holds the bus */
+  accel.setBus(&shared, 50000);
+  for(run = 0; run < REPLAYS; run++)
+  {
+    accel.setReplay(capture, capture_len);
+    if(!accel.begin())  (*errors)++;
+    accel.setMode(measure);
+    for(i = 0; i < 16; i++)
+    {
+      while(!accel.readSample10(&x, &y, &z) && accel.getLastError() == mma_ok);
+      if(x != ((i == 15) ? -512 : 3 * i - 20))  (*errors)++;
+    }
+    if(accel.readBlock(fmt_10bit, block, block + 1, block + 2, 32, 3) != 32)  (*errors)++;
+    if(block[3 * 31] != 16 * 31 - 256)  (*errors)++;
+    if(!accel.replayDone() || accel.getLastError() != mma_ok)   (*errors)++;
+  }
+  return NULL;
+}
+
+static void check_replay(void)
+{
+  pthread_t threads[THREADS];
+  int       errors[THREADS] = {0};
+  MMA_7455  handler(replay_protocol);
+  int       i = 0;
+  
+  for(i = 0; i < THREADS; i++)
+  {
+    pthread_create(&threads[i], NULL, replayer, &errors[i]);
+  }
+  for(i = 0; i < THREADS; i++)
+  {
+    pthread_join(threads[i], NULL);
+    CHECK(errors[i] == 0);
+  }
+  CHECK(shared.overlaps == 0);
+  CHECK(shared.holders == 0);
+  
+  /* a handler interrupting the owner fails at once */
+  handler.setReplay(capture, capture_len);
+  handler.setBus(&shared, 0);
+  CHECK(shared.lock(0));
+  handler.readReg(STATUS_OFF);
+  CHECK(handler.getLastError() == mma_busy);
+  shared.unlock();
+  handler.writeReg(XOFFL_OFF, 0);
+  CHECK(handler.getLastError() == mma_ok);
+  
+  printf("replay: %d threads sharing a bus, %u found busy\n",
+         THREADS, shared.getContention());
+  return;
+}
+
+int main(int argc, char** argv)
+{
+  const char*    path = (argc > 1) ? argv[1] : "fixtures/replay_basic.bin";
+  static uint8_t buff[4096];
+  
+  capture_len = check_load(path, buff, sizeof(buff));
+  capture     = buff;
+  if(capture_len == 0)  return 1;
+  
+  check_lock();
+  check_replay();
+  
+  return check_result();
+}
@@ -0,0 +1,211 @@
+/**
+ *  Name:      calib_check
+ *  Desc.:     Host check of the calibration record
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    begin(calib) is replayed against captures built here:
+ *    registers matching the record (one 21 byte burst read,
+ *    no write), registers differing (one 15 byte burst write),
+ *    an interrupt latched at boot, a record of another device
+ *    and a corrupted record (both falling back on begin()).
+ *    Then getCalibration() and a save/load round trip through
+ *    a memory store.
+ *
+ */
+
+#include "MMA7455_Calib.h"
+#include "check.h"
+
+#define REGS        (TW_OFF - DETSRC_OFF + 1)   /* DETSRC..TW */
+#define IMAGE       (TW_OFF - XOFFL_OFF + 1)    /* XOFFL..TW */
+
+static uint8_t  capture[512];
+static uint16_t length = 0;
+
+static void record(bool write, uint8_t reg, const uint8_t* buff, uint8_t len)
+{
+  capture[length++] = (write ? MMA7455_REC_WRITE : 0) | ((len - 1) & MMA7455_REC_LEN_MASK);
+  capture[length++] = reg;
+  memcpy(&capture[length], buff, len);
+  length += len;
+}
+
+static void write1(uint8_t reg, uint8_t val)
+{
+  record(true, reg, &val, 1);
+}
+
+/* the 16 writes of a cold begin() */
+static void cold_begin(void)
+{
+  const uint8_t regs[] = {XOFFL_OFF, XOFFH_OFF, YOFFL_OFF, YOFFH_OFF, ZOFFL_OFF, ZOFFH_OFF,
+                          MCTL_OFF, INTRST_OFF, INTRST_OFF, CTL1_OFF, CTL2_OFF,
+                          LDTH_OFF, PDTH_OFF, PW_OFF, LT_OFF, TW_OFF};
+  uint8_t i = 0;
+  
+  for(i = 0; i < sizeof(regs); i++)
+  {
+    write1(regs[i], (i == 7) ? (INTRST_CLRINT1 | INTRST_CLRINT2) : 0x00);
+  }
+}
+
+static void make_record(MMA7455_CALIB* calib)
+{
+  memset(calib, 0, sizeof(*calib));
+  calib->version   = MMA7455_CALIB_VERSION;
+  calib->whoami    = 0x55;
+  calib->usrinf    = 0x2A;
+  calib->range     = 4;
+  calib->offset[0] = -30;
+  calib->offset[1] = 12;
+  calib->offset[2] = 700;
+  calib->scale[0]  = MMA7455_SCALE_ONE;
+  calib->scale[1]  = MMA7455_SCALE_ONE + 164;   /* +1% */
+  calib->scale[2]  = MMA7455_SCALE_ONE - 164;
+  MMA7455_sealCalibration(calib);
+}
+
+/* DETSRC..TW as the device holding the record reads them */
+static void make_regs(const MMA7455_CALIB* calib, uint8_t* regs)
+{
+  memset(regs, 0, REGS);
+  regs[USRINF_OFF - DETSRC_OFF] = calib->usrinf;
+  regs[WHOAMI_OFF - DETSRC_OFF] = calib->whoami;
+  regs[XOFFL_OFF  - DETSRC_OFF] = calib->offset[0] & XOFFL_MASK;
+  regs[XOFFH_OFF  - DETSRC_OFF] = (calib->offset[0] >> 8) & XOFFH_MASK;
+  regs[YOFFL_OFF  - DETSRC_OFF] = calib->offset[1] & YOFFL_MASK;
+  regs[YOFFH_OFF  - DETSRC_OFF] = (calib->offset[1] >> 8) & YOFFH_MASK;
+  regs[ZOFFL_OFF  - DETSRC_OFF] = calib->offset[2] & ZOFFL_MASK;
+  regs[ZOFFH_OFF  - DETSRC_OFF] = (calib->offset[2] >> 8) & ZOFFH_MASK;
+  regs[MCTL_OFF   - DETSRC_OFF] = MCTL_GLVL_4G;
+}
+
+static bool replay(const MMA7455_CALIB* calib)
+{
+  MMA_7455 accel(replay_protocol);
+  bool     ok = false;
+  
+  accel.setReplay(capture, length);
+  ok = accel.begin(calib);
+  CHECK(accel.replayDone());
+  return ok;
+}
+
+static void check_begin(void)
+{
+  MMA7455_CALIB calib;
+  uint8_t       regs[REGS];
+  
+  make_record(&calib);
+  
+  /* registers already match: one burst read, no write */
+  length = 0;
+  make_regs(&calib, regs);
+  record(false, DETSRC_OFF, regs, REGS);
+  CHECK(replay(&calib));
+  
+  /* registers differ (power cycled): one burst write of the image */
+  length = 0;
+  memset(regs, 0, REGS);
+  regs[USRINF_OFF - DETSRC_OFF] = calib.usrinf;
+  regs[WHOAMI_OFF - DETSRC_OFF] = calib.whoami;
+  record(false, DETSRC_OFF, regs, REGS);
+  make_regs(&calib, regs);
+  record(true, XOFFL_OFF, &regs[XOFFL_OFF - DETSRC_OFF], IMAGE);
+  CHECK(replay(&calib));
+  
+  /* only the range differs: still the whole image, once */
+  length = 0;
+  make_regs(&calib, regs);
+  regs[MCTL_OFF - DETSRC_OFF] = MCTL_GLVL_8G;
+  record(false, DETSRC_OFF, regs, REGS);
+  make_regs(&calib, regs);
+  record(true, XOFFL_OFF, &regs[XOFFL_OFF - DETSRC_OFF], IMAGE);
+  CHECK(replay(&calib));
+  
+  /* interrupt latched at boot: cleared */
+  length = 0;
+  make_regs(&calib, regs);
+  regs[0] = DETSRC_INT1;
+  record(false, DETSRC_OFF, regs, REGS);
+  write1(INTRST_OFF, INTRST_CLRINT1 | INTRST_CLRINT2);
+  write1(INTRST_OFF, 0x00);
+  CHECK(replay(&calib));
+  
+  /* record of another device: cold begin(), false */
+  length = 0;
+  make_regs(&calib, regs);
+  regs[USRINF_OFF - DETSRC_OFF] ^= 0xFF;
+  record(false, DETSRC_OFF, regs, REGS);
+  cold_begin();
+  CHECK(!replay(&calib));
+  
+  /* corrupted record: no read, cold begin(), false */
+  length = 0;
+  cold_begin();
+  calib.offset[2]++;
+  CHECK(!replay(&calib));
+  return;
+}
+
+static uint8_t store_mem[64];
+
+static bool store_read(void* ctx, uint16_t addr, uint8_t* data, uint16_t len)
+{
+  (void)ctx;
+  if(addr + len > sizeof(store_mem))  return false;
+  memcpy(data, &store_mem[addr], len);
+  return true;
+}
+
+static bool store_write(void* ctx, uint16_t addr, const uint8_t* data, uint16_t len)
+{
+  (void)ctx;
+  if(addr + len > sizeof(store_mem))  return false;
+  memcpy(&store_mem[addr], data, len);
+  return true;
+}
+
+static void check_store(void)
+{
+  const MMA7455_STORE store = {store_read, store_write, NULL};
+  MMA7455_CALIB calib;
+  MMA7455_CALIB read;
+  MMA_7455      accel(replay_protocol);
+  uint8_t       regs[REGS];
+  int16_t       x = 100, y = 100, z = -100;
+  
+  /* USRINF..MCTL in one burst */
+  make_record(&calib);
+  make_regs(&calib, regs);
+  length = 0;
+  record(false, USRINF_OFF, &regs[USRINF_OFF - DETSRC_OFF], MCTL_OFF - USRINF_OFF + 1);
+  accel.setReplay(capture, length);
+  CHECK(accel.getCalibration(&read));
+  CHECK(accel.replayDone());
+  CHECK(MMA7455_checkCalibration(&read));
+  CHECK(read.whoami == calib.whoami && read.usrinf == calib.usrinf);
+  CHECK(read.range == 4);
+  CHECK(read.offset[0] == -30 && read.offset[1] == 12 && read.offset[2] == 700);
+  
+  /* round trip, then a corrupted cell is rejected */
+  CHECK(MMA7455_saveCalibration(&calib, &store, 8));
+  CHECK(MMA7455_loadCalibration(&read, &store, 8));
+  CHECK(memcmp(&read, &calib, sizeof(calib)) == 0);
+  store_mem[10] ^= 0x01;
+  CHECK(!MMA7455_loadCalibration(&read, &store, 8));
+  CHECK(!MMA7455_loadCalibration(&read, &store, sizeof(store_mem)));
+  
+  /* gain correction, rounded */
+  MMA7455_applyScale(&calib, &x, &y, &z);
+  CHECK(x == 100 && y == 101 && z == -99);
+  return;
+}
+
+int main(void)
+{
+  check_begin();
+  check_store();
+  return check_result();
+}
@@ -0,0 +1,57 @@
+/**
+ *  Name:      check
+ *  Desc.:     Helpers shared by the host checks
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    One check per file, built with all the library sources
+ *    by run_host_tests.sh. CHECK() reports the failed condition
+ *    and goes on; check_result() prints the verdict and gives
+ *    the exit code of main().
+ *
+ */
+
+#ifndef __MMA7455_CHECK_H__
+#define __MMA7455_CHECK_H__
+
+#include <stdio.h>
+#include <time.h>
+#include "MMA_7455.h"
+
+static int failures = 0;
+
+#define CHECK(cond) \
+  do { if(!(cond)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } } while(0)
+
+/* monotonic time, 1 = 1 us */
+static inline double now_us(void)
+{
+  struct timespec ts;
+  
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/* capture file into buff, 0 if it can not be read */
+static inline uint16_t check_load(const char* path, uint8_t* buff, uint16_t size)
+{
+  FILE*    file = fopen(path, "rb");
+  uint16_t len  = 0;
+  
+  if(file == NULL)
+  {
+    printf("cannot open %s\n", path);
+    return 0;
+  }
+  len = fread(buff, 1, size, file);
+  fclose(file);
+  return len;
+}
+
+static inline int check_result(void)
+{
+  printf("%s\n", failures ? "FAILED" : "ok");
+  return failures ? 1 : 0;
+}
+
+#endif /* __MMA7455_CHECK_H__ */
@@ -0,0 +1,162 @@
+/**
+ *  Name:      fall_check
+ *  Desc.:     Host check of MMA7455_FallDetector
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Synthetic magnitude profiles (Z only, 250 Hz timestamps)
+ *    are fed to add() with the default thresholds: a complete
+ *    free fall, impact and rest sequence, the three timeouts
+ *    (no impact, a spike outlasting the impact window, no
+ *    rest), a fall too short to count, and the complete
+ *    sequence again across the 32-bit time wrap.
+ *
+ */
+
+#include "MMA7455_FallDetector.h"
+#include "check.h"
+
+#define PERIOD_US   (4000UL)
+#define MAX_EVENTS  (8)
+
+typedef struct
+{
+  int16_t  mag;     /* Z, 64 = 1g */
+  uint32_t ms;
+} SEGMENT;
+
+typedef struct
+{
+  uint8_t      count;
+  MMA7455_FALL events[MAX_EVENTS];
+  uint32_t     at[MAX_EVENTS];      /* time of the sample emitting it */
+} TRACE;
+
+/* feeds the segments from t0, returns the time after the last sample */
+static uint32_t run(MMA7455_FallDetector* det, uint32_t t0,
+                    const SEGMENT* segs, uint8_t n, TRACE* trace)
+{
+  MMA7455_SAMPLE sample;
+  uint32_t       t = t0;
+  uint32_t       k = 0;
+  uint8_t        i = 0;
+  
+  memset(trace, 0, sizeof(*trace));
+  memset(&sample, 0, sizeof(sample));
+  for(i = 0; i < n; i++)
+  {
+    for(k = 0; k < segs[i].ms * 1000UL / PERIOD_US; k++, t += PERIOD_US)
+    {
+      sample.time = t;
+      sample.z    = segs[i].mag;
+      if(det->add(&sample) != fall_none && trace->count < MAX_EVENTS)
+      {
+        det->getEvent(&trace->events[trace->count]);
+        trace->at[trace->count++] = t;
+      }
+    }
+  }
+  return t;
+}
+
+/* 1g, free fall, a 12 ms shock, then still */
+static void check_sequence(uint32_t t0)
+{
+  const SEGMENT segs[] = {{64, 200}, {0, 300}, {250, 12}, {64, 1500}};
+  MMA7455_FallDetector det;
+  TRACE    tr;
+  /* uint32_t: the expected times wrap as the timestamps do */
+  uint32_t fall   = t0 + 200000UL;      /* first sample under 0.3g */
+  uint32_t shock  = fall + 300000UL;
+  uint32_t still  = shock + 12000UL;
+  uint32_t fired  = fall + 100000UL;
+  uint32_t rest   = still + PERIOD_US;
+  
+  run(&det, t0, segs, 4, &tr);
+  CHECK(tr.count == 3);
+  CHECK(tr.events[0].event == fall_freefall_event);
+  CHECK(tr.events[0].time == fall && tr.events[0].duration == 100000UL);
+  CHECK(tr.at[0] == fired);
+  CHECK(tr.events[1].event == fall_impact_event);
+  CHECK(tr.events[1].time == shock && tr.events[1].duration == 12000UL);
+  CHECK(tr.events[1].peak == 250);
+  CHECK(tr.events[2].event == fall_rest_event);
+  CHECK(tr.events[2].time == rest);
+  CHECK(tr.events[2].duration == 1000000UL);
+  CHECK(det.getState() == fall_idle);
+  return;
+}
+
+static void check_timeouts(void)
+{
+  MMA7455_FallDetector det;
+  TRACE    tr;
+  uint32_t t = 0;
+  
+  /* free fall, then 1g and no impact: timeout 1 s after the fall */
+  {
+    const SEGMENT segs[] = {{64, 100}, {0, 200}, {64, 1100}};
+    uint32_t last = 100000UL + 200000UL - PERIOD_US;
+    
+    run(&det, 0, segs, 3, &tr);
+    CHECK(tr.count == 2);
+    CHECK(tr.events[1].event == fall_timeout_event);
+    CHECK(tr.events[1].time == last);
+    CHECK(tr.events[1].duration == 1000000UL + PERIOD_US);
+    CHECK(tr.events[1].peak == 0);
+    CHECK(det.getState() == fall_idle);
+  }
+  
+  /* spike held over the impact threshold: timeout with its
+   * peak, then a new fall is still detected */
+  {
+    const SEGMENT segs[] = {{64, 100}, {0, 200}, {200, 500}, {230, 1000},
+                            {64, 100}, {0, 200}};
+    uint32_t spike = 300000UL;
+    
+    det.reset();
+    run(&det, 0, segs, 6, &tr);
+    CHECK(tr.count == 3);
+    CHECK(tr.events[1].event == fall_timeout_event);
+    CHECK(tr.events[1].time == spike);
+    CHECK(tr.events[1].duration == 1000000UL + PERIOD_US);
+    CHECK(tr.events[1].peak == 230);
+    CHECK(tr.events[2].event == fall_freefall_event);
+  }
+  
+  /* impact, then moving (1.5g) without rest: timeout 10 s after */
+  {
+    const SEGMENT segs[] = {{64, 100}, {0, 200}, {250, 8}, {96, 10100}};
+    uint32_t end = 300000UL + 8000UL;
+    
+    det.reset();
+    t = run(&det, 0, segs, 4, &tr);
+    CHECK(tr.count == 3);
+    CHECK(tr.events[1].event == fall_impact_event);
+    CHECK(tr.events[2].event == fall_timeout_event);
+    CHECK(tr.events[2].time == end);
+    CHECK(tr.events[2].duration == 10000000UL + PERIOD_US);
+    CHECK(det.getState() == fall_idle);
+    CHECK(t > tr.at[2]);
+  }
+  
+  /* under the threshold for less than 100 ms: nothing */
+  {
+    const SEGMENT segs[] = {{64, 100}, {0, 96}, {64, 2000}};
+    
+    det.reset();
+    run(&det, 0, segs, 3, &tr);
+    CHECK(tr.count == 0);
+    CHECK(det.getState() == fall_idle);
+  }
+  return;
+}
+
+int main(void)
+{
+  check_sequence(0);
+  /* the free fall starts 50 ms before the 32-bit time wraps */
+  check_sequence(0xFFFFFFFFUL - 250000UL + 1);
+  check_timeouts();
+  return check_result();
+}
@@ -0,0 +1,132 @@
+/**
+ *  Name:      fft_check
+ *  Desc.:     Host check of MMA7455_FFT against a float DFT
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    For every size (16 to 512) and window, random 10-bit
+ *    blocks, sines and a constant are transformed and every
+ *    bin is compared to a double precision DFT of the same
+ *    windowed block, scaled to the units of transform().
+ *    Tolerance: 8 (1/2 count) on every bin. The largest error
+ *    seen and the time per transform are reported.
+ *
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "MMA7455_FFT.h"
+#include "check.h"
+
+#define TOLERANCE   (8.0)   /* 1 = 1/16 count */
+#define RANDOM_RUNS (20)
+#define TIMED_RUNS  (2000)
+
+/* |X[k]| of the windowed block, in 1/16 count:
+ * a centered sine of amplitude A reads 16.A, bin 0 the mean */
+static void reference(const int16_t* block, uint16_t n, FFT_WINDOW window, double* mags)
+{
+  uint16_t i = 0;
+  uint16_t k = 0;
+  double   w = 0;
+  double   re = 0, im = 0;
+  double   gain = (window == fft_hann) ? 2.0 : 1.0;
+  
+  for(k = 0; k < n / 2; k++)
+  {
+    re = 0;
+    im = 0;
+    for(i = 0; i < n; i++)
+    {
+      w = (window == fft_hann) ? pow(sin(M_PI * i / n), 2) : 1.0;
+      re += w * block[i] * cos(2 * M_PI * k * i / n);
+      im -= w * block[i] * sin(2 * M_PI * k * i / n);
+    }
+    mags[k] = gain * 32.0 * sqrt(re * re + im * im) / n;
+    if(k == 0)  mags[k] /= 2;
+  }
+  return;
+}
+
+/* largest bin error of one block */
+static double compare(uint16_t n, FFT_WINDOW window, const int16_t* block, const char* name)
+{
+  static int16_t work[MMA7455_FFT_MAX];
+  static double  ref[MMA7455_FFT_MAX / 2];
+  MMA7455_FFT    fft(n, window);
+  uint16_t*      mags = NULL;
+  double         err  = 0;
+  double         max  = 0;
+  uint16_t       k    = 0;
+  
+  memcpy(work, block, n * sizeof(int16_t));
+  mags = fft.transform(work);
+  reference(block, n, window, ref);
+  for(k = 0; k < n / 2; k++)
+  {
+    err = fabs(mags[k] - ref[k]);
+    if(err > max)   max = err;
+    if(err > TOLERANCE)
+    {
+      printf("n %u %s %s: bin %u reads %u, expected %.1f\n", n,
+             (window == fft_hann) ? "hann" : "rect", name, k, mags[k], ref[k]);
+      failures++;
+      break;
+    }
+  }
+  return max;
+}
+
+int main(void)
+{
+  static int16_t block[MMA7455_FFT_MAX];
+  static int16_t work[MMA7455_FFT_MAX];
+  FFT_WINDOW     window = fft_rectangular;
+  uint16_t       n      = 0;
+  uint16_t       i      = 0;
+  int            run    = 0;
+  double         err    = 0;
+  double         max    = 0;
+  double         start  = 0;
+  double         elapsed = 0;
+  
+  srand(7455);
+  for(n = MMA7455_FFT_MIN; n <= MMA7455_FFT_MAX; n <<= 1)
+  {
+    for(window = fft_rectangular; window <= fft_hann; window = (FFT_WINDOW)(window + 1))
+    {
+      MMA7455_FFT fft(n, window);
+      
+      max = 0;
+      for(run = 0; run < RANDOM_RUNS; run++)
+      {
+        for(i = 0; i < n; i++)    block[i] = (int16_t)(rand() % 1024) - 512;
+        err = compare(n, window, block, "random");
+        if(err > max)   max = err;
+      }
+      for(i = 0; i < n; i++)  block[i] = (int16_t)lround(500 * sin(2 * M_PI * 3 * i / n));
+      err = compare(n, window, block, "sine bin 3");
+      if(err > max)   max = err;
+      for(i = 0; i < n; i++)  block[i] = (int16_t)lround(64 + 100 * cos(2 * M_PI * (n / 4 + 0.5) * i / n));
+      err = compare(n, window, block, "sine between bins");
+      if(err > max)   max = err;
+      for(i = 0; i < n; i++)  block[i] = -300;
+      err = compare(n, window, block, "constant");
+      if(err > max)   max = err;
+      
+      /* fresh copy each time: the transform is in place */
+      start = now_us();
+      for(run = 0; run < TIMED_RUNS; run++)
+      {
+        memcpy(work, block, n * sizeof(int16_t));
+        fft.transform(work);
+      }
+      elapsed = now_us() - start;
+      
+      printf("n %3u %s: max error %.2f (1/16 count), %.2f us/transform\n", n,
+             (window == fft_hann) ? "hann" : "rect", max, elapsed / TIMED_RUNS);
+    }
+  }
+  
+  return check_result();
+}
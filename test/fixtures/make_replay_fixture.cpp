@@ -0,0 +1,109 @@
+/**
+ *  Name:      make_replay_fixture
+ *  Desc.:     Writes test/fixtures/replay_basic.bin
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Synthetic capture, in the format of setCapture(), of the
+ *    transfers made by begin(), setMode(measure), 16 calls to
+ *    readSample10() (STATUS polled, one sample not ready on the
+ *    first poll, one overrun) and readBlock() of 32 samples
+ *    read on a DRDY pin (no STATUS). The sample values follow
+ *    the formulas of replay_check.cpp.
+ *
+ *    g++ -I. test/fixtures/make_replay_fixture.cpp \
+ *        -o make_replay_fixture && ./make_replay_fixture
+ *
+ */
+
+#include <stdio.h>
+#include "MMA_7455.h"
+
+static uint8_t  capture[1024];
+static uint16_t length = 0;
+
+static void record(bool write, uint8_t reg, const uint8_t* buff, uint8_t len)
+{
+  capture[length++] = (write ? MMA7455_REC_WRITE : 0) | ((len - 1) & MMA7455_REC_LEN_MASK);
+  capture[length++] = reg;
+  memcpy(&capture[length], buff, len);
+  length += len;
+}
+
+static void write1(uint8_t reg, uint8_t val)
+{
+  record(true, reg, &val, 1);
+}
+
+static void read1(uint8_t reg, uint8_t val)
+{
+  record(false, reg, &val, 1);
+}
+
+static void sample(int16_t x, int16_t y, int16_t z)
+{
+  int16_t val[3] = {x, y, z};
+  uint8_t buff[6];
+  uint8_t i = 0;
+  
+  for(i = 0; i < 3; i++)
+  {
+    buff[2 * i]     = (uint16_t)val[i] & 0xFF;
+    buff[2 * i + 1] = ((uint16_t)val[i] >> 8) & XOUTH_MASK;
+  }
+  record(false, XOUTL_OFF, buff, 6);
+}
+
+int main(int argc, char** argv)
+{
+  const char* path = (argc > 1) ? argv[1] : "test/fixtures/replay_basic.bin";
+  FILE*       file = NULL;
+  int         i    = 0;
+  
+  /* begin() */
+  write1(XOFFL_OFF,  0x00);
+  write1(XOFFH_OFF,  0x00);
+  write1(YOFFL_OFF,  0x00);
+  write1(YOFFH_OFF,  0x00);
+  write1(ZOFFL_OFF,  0x00);
+  write1(ZOFFH_OFF,  0x00);
+  write1(MCTL_OFF,   0x00);
+  write1(INTRST_OFF, 0x03);
+  write1(INTRST_OFF, 0x00);
+  write1(CTL1_OFF,   0x00);
+  write1(CTL2_OFF,   0x00);
+  write1(LDTH_OFF,   0x00);
+  write1(PDTH_OFF,   0x00);
+  write1(PW_OFF,     0x00);
+  write1(LT_OFF,     0x00);
+  write1(TW_OFF,     0x00);
+  
+  /* setMode(measure) */
+  read1(MCTL_OFF, 0x00);
+  write1(MCTL_OFF, MCTL_MOD_MSMT);
+  
+  /* readSample10() */
+  for(i = 0; i < 16; i++)
+  {
+    if(i == 9)  read1(STATUS_OFF, 0x00);
+    read1(STATUS_OFF, (i == 5) ? (STATUS_DRDY | STATUS_DOVR) : STATUS_DRDY);
+    if(i == 15) sample(-512, 511, 64);
+    else        sample(3 * i - 20, -5 * i, 64 + (i & 7));
+  }
+  
+  /* readBlock() */
+  for(i = 0; i < 32; i++)
+  {
+    sample(16 * i - 256, 511 - i, -i);
+  }
+  
+  file = fopen(path, "wb");
+  if(file == NULL || fwrite(capture, 1, length, file) != length)
+  {
+    fprintf(stderr, "cannot write %s\n", path);
+    return 1;
+  }
+  fclose(file);
+  printf("%s: %u bytes\n", path, length);
+  return 0;
+}
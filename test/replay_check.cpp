@@ -0,0 +1,105 @@
+/**
+ *  Name:      replay_check
+ *  Desc.:     Host check of the replay transport
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Replays fixtures/replay_basic.bin (see
+ *    fixtures/make_replay_fixture.cpp) through begin(),
+ *    setMode(), readSample10() and readBlock(), checks the
+ *    decoded samples and the overrun count, then reports
+ *    the replay throughput.
+ *
+ */
+
+#include "check.h"
+
+#define SAMPLES   16
+#define BLOCK     32
+#define RUNS      2000
+
+/* one pass over the capture, returns the samples decoded */
+static uint16_t replay(MMA_7455* accel, const uint8_t* buff, uint16_t len, bool verify)
+{
+  int16_t  x = 0, y = 0, z = 0;
+  int16_t  block[3 * BLOCK];
+  uint16_t count = 0;
+  int      i = 0;
+  int      polls = 0;
+  
+  accel->setReplay(buff, len);
+  if(verify)  CHECK(accel->begin());
+  else        accel->begin();
+  accel->setMode(measure);
+  
+  for(i = 0; i < SAMPLES; i++)
+  {
+    for(polls = 1; !accel->readSample10(&x, &y, &z) && polls < 4; polls++);
+    if(!verify)   continue;
+    CHECK(polls == ((i == 9) ? 2 : 1));
+    if(i == 15)
+    {
+      CHECK(x == -512 && y == 511 && z == 64);
+    }
+    else
+    {
+      CHECK(x == 3 * i - 20);
+      CHECK(y == -5 * i);
+      CHECK(z == 64 + (i & 7));
+    }
+  }
+  count = SAMPLES;
+  
+  /* interleaved XYZ */
+  count += accel->readBlock(fmt_10bit, block, block + 1, block + 2, BLOCK, 3);
+  if(verify)
+  {
+    CHECK(count == SAMPLES + BLOCK);
+    for(i = 0; i < BLOCK; i++)
+    {
+      CHECK(block[3 * i]     == 16 * i - 256);
+      CHECK(block[3 * i + 1] == 511 - i);
+      CHECK(block[3 * i + 2] == -i);
+    }
+    CHECK(accel->getOverrunCount() == 1);
+    CHECK(accel->getLastError() == mma_ok);
+    CHECK(accel->replayDone());
+  }
+  return count;
+}
+
+int main(int argc, char** argv)
+{
+  const char* path    = (argc > 1) ? argv[1] : "fixtures/replay_basic.bin";
+  static uint8_t buff[4096];
+  uint16_t    len     = 0;
+  uint32_t    samples = 0;
+  double      start   = 0;
+  double      elapsed = 0;
+  int         i       = 0;
+  
+  len = check_load(path, buff, sizeof(buff));
+  if(len == 0)  return 1;
+  
+  {
+    MMA_7455 accel(replay_protocol);
+    
+    replay(&accel, buff, len, true);
+    
+    /* a write that differs from the capture is reported */
+    accel.setReplay(buff, len);
+    accel.writeReg(XOFFL_OFF, 0x55);
+    CHECK(accel.getLastError() == mma_replay_mismatch);
+    
+    start = now_us();
+    for(i = 0; i < RUNS; i++)
+    {
+      samples += replay(&accel, buff, len, false);
+    }
+    elapsed = now_us() - start;
+  }
+  
+  printf("replay: %u bytes, %u samples in %.0f us, %.3f us/sample\n",
+         len, (unsigned)samples, elapsed, elapsed / samples);
+  return check_result();
+}
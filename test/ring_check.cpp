@@ -0,0 +1,226 @@
+/**
+ *  Name:      ring_check
+ *  Desc.:     Host check of MMA7455_Ring
+ *  License:   GPLv2
+ *
+ *  Notes:
+ *    Fills a ring from the replay of fixtures/replay_basic.bin
+ *    and checks readers of different paces, the overwrite and
+ *    lost accounting and the release of a slot reused while
+ *    being read. Then one writer thread and several reader
+ *    threads check that no torn sample is ever returned and
+ *    that every sample is either read or counted as lost.
+ *
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include "MMA7455_Ring.h"
+#include "check.h"
+
+#define STRESS_SLOTS    16
+#define STRESS_SAMPLES  500000UL
+#define STRESS_READERS  3
+
+static int16_t expected_x(int i)
+{
+  return (i == 15) ? -512 : 3 * i - 20;
+}
+
+static void check_replay(const uint8_t* buff, uint16_t len)
+{
+  static uint8_t      mem[MMA7455_RING_SIZE(8)];
+  MMA_7455            accel(replay_protocol);
+  MMA7455_Ring        ring;
+  MMA7455_Ring        other;
+  MMA7455_RING_READER each, slow, late;
+  MMA7455_SAMPLE      sample;
+  int                 i = 0;
+  int                 got = 0;
+  
+  CHECK(ring.begin(mem, sizeof(mem)));
+  CHECK(ring.getSlots() == 8);
+  /* a second view of the same block, as another process would */
+  CHECK(other.attach(mem, sizeof(mem)));
+  
+  accel.setReplay(buff, len);
+  CHECK(accel.begin());
+  accel.setMode(measure);
+  ring.openReader(&each);
+  ring.openReader(&slow);
+  ring.openReader(&late);
+  
+  /* 16 polled samples, one STATUS poll not ready */
+  for(i = 0; i < 16; )
+  {
+    if(!ring.acquire(&accel))
+    {
+      CHECK(accel.getLastError() == mma_ok);
+      continue;
+    }
+    i++;
+    
+    /* reads every sample */
+    CHECK(other.read(&each, &sample));
+    CHECK(sample.x == expected_x(i - 1));
+    CHECK(!other.read(&each, &sample));
+    
+    /* reads 4 at a time: never lapped */
+    if(i % 4 == 0)
+    {
+      for(got = 0; other.read(&slow, &sample); got++)
+      {
+        CHECK(sample.x == expected_x(i - 4 + got));
+      }
+      CHECK(got == 4);
+    }
+  }
+  CHECK(ring.getHead() == 16);
+  CHECK(each.lost == 0 && slow.lost == 0);
+  
+  /* never read: lapped, the oldest 8 were overwritten */
+  for(got = 0; other.read(&late, &sample); got++)
+  {
+    CHECK(sample.x == expected_x(8 + got));
+  }
+  CHECK(got == 8);
+  CHECK(late.lost == 8);
+  CHECK(late.next == 16);
+  
+  /* slot reused while read in place: release() rejects it */
+  sample.x = 100;
+  ring.push(&sample);
+  CHECK(other.peek(&late) != NULL);
+  for(i = 0; i < 8; i++)    ring.push(&sample);
+  CHECK(!other.release(&late));
+  CHECK(late.lost == 9);
+  
+  /* unformatted or mismatched memory is not attached */
+  mem[0] ^= 0xFF;
+  CHECK(!other.attach(mem, sizeof(mem)));
+  mem[0] ^= 0xFF;
+  CHECK(!other.attach(mem, MMA7455_RING_SIZE(4)));
+  return;
+}
+
+/* stress: every field derived from the sequence,
+ * so a torn sample is caught by any reader */
+static uint8_t      stress_mem[MMA7455_RING_SIZE(STRESS_SLOTS)];
+static MMA7455_Ring stress_ring;
+static volatile int stress_done = 0;
+
+typedef struct
+{
+  MMA7455_RING_READER reader;
+  uint32_t            read;
+  uint32_t            torn;
+  uint32_t            order;
+} STRESS_READER;
+
+static void stress_sample(uint32_t i, MMA7455_SAMPLE* sample)
+{
+  sample->time = i;
+  sample->x    = (int16_t)(i & 0x3FF) - 512;
+  sample->y    = (int16_t)((i >> 10) & 0x3FF) - 512;
+  sample->z    = (int16_t)(~i & 0x3FF) - 512;
+  return;
+}
+
+static void* stress_writer(void* arg)
+{
+  MMA7455_SAMPLE sample;
+  uint32_t       i = 0;
+  
+  (void)arg;
+  for(i = 0; i < STRESS_SAMPLES; i++)
+  {
+    stress_sample(i, &sample);
+    stress_ring.push(&sample);
+    /* paced like a sensor, with bursts that lap the readers */
+    if((i & 0x4000) == 0 && (i & 7) == 7)   sched_yield();
+  }
+  __atomic_store_n(&stress_done, 1, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+static void* stress_reader(void* arg)
+{
+  STRESS_READER* r = (STRESS_READER*)arg;
+  MMA7455_SAMPLE sample;
+  MMA7455_SAMPLE ref;
+  uint32_t       last = 0;
+  bool           first = true;
+  int            done = 0;
+  
+  for(;;)
+  {
+    done = __atomic_load_n(&stress_done, __ATOMIC_ACQUIRE);
+    while(stress_ring.read(&r->reader, &sample))
+    {
+      stress_sample(sample.time, &ref);
+      if(sample.x != ref.x || sample.y != ref.y || sample.z != ref.z)  r->torn++;
+      if(!first && sample.time <= last)   r->order++;
+      last  = sample.time;
+      first = false;
+      r->read++;
+    }
+    if(done)    break;
+    sched_yield();
+  }
+  return NULL;
+}
+
+static void check_stress(void)
+{
+  pthread_t     writer;
+  pthread_t     threads[STRESS_READERS];
+  STRESS_READER readers[STRESS_READERS];
+  double        start = 0;
+  double        elapsed = 0;
+  int           i = 0;
+  
+  CHECK(stress_ring.begin(stress_mem, sizeof(stress_mem)));
+  for(i = 0; i < STRESS_READERS; i++)
+  {
+    memset(&readers[i], 0, sizeof(readers[i]));
+    stress_ring.openReader(&readers[i].reader);
+  }
+  
+  start = now_us();
+  for(i = 0; i < STRESS_READERS; i++)
+  {
+    pthread_create(&threads[i], NULL, stress_reader, &readers[i]);
+  }
+  pthread_create(&writer, NULL, stress_writer, NULL);
+  pthread_join(writer, NULL);
+  for(i = 0; i < STRESS_READERS; i++)   pthread_join(threads[i], NULL);
+  elapsed = now_us() - start;
+  
+  for(i = 0; i < STRESS_READERS; i++)
+  {
+    CHECK(readers[i].torn == 0);
+    CHECK(readers[i].order == 0);
+    CHECK(readers[i].reader.next == STRESS_SAMPLES);
+    CHECK(readers[i].read + readers[i].reader.lost == STRESS_SAMPLES);
+    printf("reader %d: %lu read, %lu lost\n", i,
+           (unsigned long)readers[i].read, (unsigned long)readers[i].reader.lost);
+  }
+  printf("stress: %lu samples, %d slots, %d readers, %.1f ns/sample\n",
+         STRESS_SAMPLES, STRESS_SLOTS, STRESS_READERS,
+         elapsed * 1e3 / STRESS_SAMPLES);
+  return;
+}
+
+int main(int argc, char** argv)
+{
+  const char*    path = (argc > 1) ? argv[1] : "fixtures/replay_basic.bin";
+  static uint8_t buff[4096];
+  uint16_t       len  = check_load(path, buff, sizeof(buff));
+  
+  if(len == 0)  return 1;
+  
+  check_replay(buff, len);
+  check_stress();
+  
+  return check_result();
+}
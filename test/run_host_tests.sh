@@ -0,0 +1,39 @@
+#!/bin/bash
+#
+#  Name:      run_host_tests.sh
+#  Desc.:     Build and run the host checks of the library
+#  License:   GPLv2
+#
+#  Usage:     test/run_host_tests.sh
+#             (CXX selects the compiler, default g++)
+#
+#  Every test/*.cpp is built against all the library sources
+#  as a host build (without ARDUINO: replay transport only)
+#  and run from the test directory; they share the helpers
+#  of test/check.h. The script fails if any check fails to
+#  build or reports a failure.
+#
+
+set -u
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+CXX="${CXX:-g++}"
+BUILD="$(mktemp -d)"
+trap 'rm -rf "$BUILD"' EXIT
+
+rc=0
+for t in "$ROOT"/test/*.cpp; do
+  name="$(basename "$t" .cpp)"
+  echo "== $name"
+  if ! "$CXX" -std=gnu++11 -O2 -Wall -Wextra -pthread -I"$ROOT" \
+       "$t" "$ROOT"/*.cpp -o "$BUILD/$name"; then
+    echo "FAIL: $name does not build"
+    rc=1
+    continue
+  fi
+  if ! (cd "$ROOT/test" && "$BUILD/$name"); then
+    echo "FAIL: $name"
+    rc=1
+  fi
+done
+exit $rc